@@ -2,6 +2,15 @@
 #define BST_H_INCLUDED
 
 #include <iostream>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include "BstBalance.h"
+#include "BstAlloc.h"
+#include "BstAugment.h"
 using std::cout;
 using std::endl;
 
@@ -17,15 +26,39 @@ using std::endl;
  * - Insert a new value
  * - Search for a value
  * - Delete a specific value
+ * - Bulk-build from sorted values in linear time
  * - Clear the entire tree
  * - In-order, pre-order, and post-order traversal
+ * - In-order iteration with begin() / end()
+ * - With BstSize: the k-th smallest value (Select) and ranks (Rank)
+ * - With BstAggregate: count, mean and SD over any range (Summarize)
+ *
+ * The Balance policy decides whether the tree rebalances itself (see
+ * BstBalance.h). With the default BstUnbalanced the shape follows the
+ * insertion order; with BstAvl every operation stays O(log n).
+ *
+ * The Alloc policy decides where nodes live (see BstAlloc.h). BstHeap
+ * news and deletes each node; BstArena carves them out of slabs owned by
+ * the tree and frees a whole tree in one go.
+ *
+ * The Augment policy decides what each node caches about its subtree (see
+ * BstAugment.h). BstPlain caches nothing; BstSize keeps subtree sizes for
+ * order-statistic queries; BstAggregate adds per-field sums for range
+ * statistics.
  *
  * @tparam T Type of elements stored in the BST.
+ * @tparam Balance Balancing policy, BstUnbalanced or BstAvl.
+ * @tparam Alloc Node allocation policy, BstHeap or BstArena.
+ * @tparam Augment Per-node subtree data, BstPlain, BstSize or BstAggregate.
  */
-template <class T>
+template <class T, class Balance = BstUnbalanced, class Alloc = BstHeap, class Augment = BstPlain>
 class Bst
 {
+private:
+    struct Node;
+
 public:
+    class Iterator;
     /**
      * @brief Constructs an empty BST.
      */
@@ -34,7 +67,7 @@ public:
     /**
      * @brief Destructor.
      *
-     * Recursively deallocates all nodes in the tree.
+     * Deallocates all nodes in the tree.
      */
     ~Bst();
 
@@ -57,14 +90,35 @@ public:
      */
     Bst& operator=(const Bst& other);
 
+    /**
+     * @brief Move constructor.
+     *
+     * Takes the nodes (and the pool they live in) of @p other without
+     * copying any of them, leaving @p other empty.
+     *
+     * @param other Tree to move from.
+     */
+    Bst(Bst&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator.
+     *
+     * Frees this tree's nodes, then takes those of @p other, leaving it empty.
+     *
+     * @param other Tree to move from.
+     * @return Reference to this instance.
+     */
+    Bst& operator=(Bst&& other) noexcept;
+
     /**
      * @brief Inserts a value into the BST.
      *
      * Duplicate values are ignored and not inserted.
      *
      * @param value The value to insert.
+     * @return True if the value was inserted, false if it was a duplicate.
      */
-    void Insert(const T& value);
+    bool Insert(const T& value);
 
     /**
      * @brief Searches for a value in the BST.
@@ -94,27 +148,202 @@ public:
      * Order: **Left → Root → Right**
      * Produces sorted output if the BST contains no duplicates.
      *
-     * @param func Function applied to each visited node's value.
+     * @p func may be a function, functor or lambda taking const T&. If it
+     * returns bool, returning false stops the traversal there.
+     *
+     * @param func Callable applied to each visited node's value.
+     * @return False if @p func stopped the traversal early.
      */
-    void InOrder(void (*func)(const T&)) const;
+    template <class Func>
+    bool InOrder(Func func) const;
 
     /**
      * @brief Performs a pre-order traversal.
      *
      * Order: **Root → Left → Right**
      *
-     * @param func Function applied to each visited node's value.
+     * @param func Callable applied to each visited node's value; see InOrder.
+     * @return False if @p func stopped the traversal early.
      */
-    void PreOrder(void (*func)(const T&)) const;
+    template <class Func>
+    bool PreOrder(Func func) const;
 
     /**
      * @brief Performs a post-order traversal.
      *
      * Order: **Left → Right → Root**
      *
-     * @param func Function applied to each visited node's value.
+     * @param func Callable applied to each visited node's value; see InOrder.
+     * @return False if @p func stopped the traversal early.
+     */
+    template <class Func>
+    bool PostOrder(Func func) const;
+
+    /**
+     * @brief Visits, in order, every value v with lo <= v <= hi.
+     *
+     * Subtrees entirely below @p lo are never entered, and the walk stops
+     * at the first value above @p hi, so a query costs O(height + k) for
+     * k values in range.
+     *
+     * @param lo Lower bound, inclusive.
+     * @param hi Upper bound, inclusive.
+     * @param visitor Callable invoked as visitor(const T&) for each value;
+     *        may stop the walk early like InOrder's callable.
+     * @return False if @p visitor stopped the walk early.
+     */
+    template <class Visitor>
+    bool VisitRange(const T& lo, const T& hi, Visitor visitor) const;
+
+    /**
+     * @brief Iterator at the smallest value.
+     *
+     * Iterators are invalidated by any change to the tree.
+     */
+    Iterator begin() const;
+
+    /**
+     * @brief Iterator one past the largest value.
+     */
+    Iterator end() const;
+
+    /**
+     * @brief Returns the number of levels in the tree.
+     *
+     * An empty tree has height 0 and a single node has height 1.
+     *
+     * @return Length of the longest root-to-leaf path, in nodes.
      */
-    void PostOrder(void (*func)(const T&)) const;
+    int GetHeight() const;
+
+    /**
+     * @brief Rebuilds the tree perfectly balanced, nodes allocated in order.
+     *
+     * The nodes are recreated in sorted order, so with BstArena an
+     * in-order traversal walks memory front to back. Worth calling once a
+     * tree has finished loading. O(n) time and O(n) temporary space.
+     */
+    void Compact();
+
+    /**
+     * @brief Adds a run of values, building a perfectly balanced tree directly.
+     *
+     * If [first, last) is in ascending order it is merged with the values
+     * already in the tree and the tree is rebuilt by linking nodes, in
+     * O(n) with no searches; the nodes are created in sorted order, in one
+     * contiguous block with BstArena. Otherwise each value is Insert()ed
+     * in turn. Either way, a value equal to one already present (in the
+     * tree or earlier in the run) is not added.
+     *
+     * @param first Iterator to the first value.
+     * @param last Iterator one past the last value.
+     * @return Number of values not added because they were duplicates.
+     */
+    template <class Iter>
+    int BuildFromSorted(Iter first, Iter last);
+
+    /**
+     * @brief Returns the number of values in the tree.
+     *
+     * Needs an Augment policy that keeps subtree sizes (BstSize). O(1).
+     */
+    int GetSize() const;
+
+    /**
+     * @brief Returns the k-th smallest value, counting from 0.
+     *
+     * Needs an Augment policy that keeps subtree sizes (BstSize). O(height).
+     *
+     * @param k Position in sorted order.
+     * @return The value, or nullptr if @p k is not in [0, size).
+     */
+    const T* Select(int k) const;
+
+    /**
+     * @brief Counts the values smaller than @p value.
+     *
+     * This is the position @p value has, or would have, in sorted order.
+     * Needs an Augment policy that keeps subtree sizes (BstSize). O(height).
+     *
+     * @param value Value to rank; need not be in the tree.
+     * @return Number of values less than @p value.
+     */
+    int Rank(const T& value) const;
+
+    /**
+     * @brief Aggregates every value v with lo <= v <= hi.
+     *
+     * Whole subtrees inside the range are taken from their cached
+     * aggregates, so only the two boundary paths are walked: O(height)
+     * however many values are in range. Needs an Augment policy with a
+     * Summary (BstAggregate).
+     *
+     * @param lo Lower bound, inclusive.
+     * @param hi Upper bound, inclusive.
+     * @return Aggregates of the values in range; empty if lo > hi.
+     */
+    template <class A = Augment>
+    typename A::Summary Summarize(const T& lo, const T& hi) const;
+
+    /**
+     * @brief Aggregates every value in the tree, in O(1).
+     */
+    template <class A = Augment>
+    typename A::Summary Summarize() const;
+
+    /**
+     * @class Iterator
+     * @brief Read-only bidirectional iterator over the values in order.
+     *
+     * Nodes have no parent pointers, so the iterator keeps the path from
+     * the root down to its node. Stepping is amortised O(1) and at worst
+     * O(height); copying an iterator copies that path.
+     */
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        /** @brief An iterator that belongs to no tree. */
+        Iterator();
+
+        /** @brief The current value. */
+        const T& operator*() const;
+
+        /** @brief Member access on the current value. */
+        const T* operator->() const;
+
+        /** @brief Moves to the next larger value, or to end(). */
+        Iterator& operator++();
+
+        /** @brief Postfix form of operator++. */
+        Iterator operator++(int);
+
+        /** @brief Moves to the next smaller value; from end(), to the largest. */
+        Iterator& operator--();
+
+        /** @brief Postfix form of operator--. */
+        Iterator operator--(int);
+
+        /** @brief True if both point at the same node, or both are end(). */
+        bool operator==(const Iterator& other) const;
+
+        /** @brief Negation of operator==. */
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        friend class Bst;
+
+        const Node* m_root;              ///< Root of the tree, to step back from end().
+        std::vector<const Node*> m_path; ///< Root to current node; empty at end().
+
+        /** @brief Pushes @p node and then its leftmost (or rightmost) descendants. */
+        void descend(const Node* node, bool leftmost);
+    };
 
 private:
 
@@ -122,103 +351,146 @@ private:
      * @struct Node
      * @brief Represents a single BST node.
      */
-    struct Node
+    struct Node : public Balance::NodeBase, public Augment::NodeBase
     {
         T data;        ///< Value stored at this node.
         Node* left;    ///< Pointer to the left child.
         Node* right;   ///< Pointer to the right child.
-    };
 
-    Node* root; ///< Pointer to the root of the BST.
+        /**
+         * @brief Creates a leaf holding @p value.
+         */
+        explicit Node(const T& value)
+            : data(value), left(nullptr), right(nullptr)
+        {
+        }
+
+        /**
+         * @brief Recomputes the augmented data once the children are final.
+         */
+        void Refresh()
+        {
+            Augment::Update(this);
+        }
+    };
 
     /**
-     * @brief Recursive insert helper.
-     * @param node Current subtree root.
-     * @param value Value to insert.
-     * @return Updated subtree root pointer.
+     * @brief True if Insert and DeleteNode must revisit the path they took.
      */
-    Node* insert(Node* node, const T& value);
+    static const bool keepsPath = Balance::rebalances || Augment::augments;
+
+    Node* root; ///< Pointer to the root of the BST.
+
+    typename Alloc::template Pool<Node> pool; ///< Where this tree's nodes are allocated.
 
     /**
-     * @brief Recursive search helper.
-     * @param node Current subtree root.
-     * @param value Value to locate.
-     * @return True if the value is found.
+     * @brief Child links (or &root) from the root down to the last change.
+     *
+     * Filled by Insert and DeleteNode only when a policy rebalances or
+     * augments, and reused between calls so an insert does not allocate.
      */
-    bool search(Node* node, const T& value) const;
+    std::vector<Node**> path;
 
     /**
-     * @brief Recursive in-order traversal helper.
+     * @brief Rebalances (or just refreshes) the nodes recorded in path, deepest first.
      */
-    void inOrder(const Node* node, void (*func)(const T&)) const;
+    void rebalancePath();
 
     /**
-     * @brief Recursive pre-order traversal helper.
+     * @brief Frees a subtree without recursion or an explicit stack.
+     * @param node Subtree root to delete.
      */
-    void preOrder(const Node* node, void (*func)(const T&)) const;
+    void deleteTree(Node* node);
 
     /**
-     * @brief Recursive post-order traversal helper.
+     * @brief Clones a subtree using an explicit stack.
+     * @param node Root of the subtree to clone.
+     * @return New subtree root.
      */
-    void postOrder(const Node* node, void (*func)(const T&)) const;
+    Node* copyTree(const Node* node);
 
     /**
-     * @brief Recursive destroy helper.
-     * @param node Subtree root to delete.
+     * @brief Links sorted, unique nodes into a perfectly balanced tree.
+     * @param nodes Nodes in ascending order, children not yet set.
+     * @return Root of the new tree.
      */
-    void deleteTree(Node* node);
+    Node* linkBalanced(const std::vector<Node*>& nodes);
 
     /**
-     * @brief Recursive delete-node helper.
-     * @param node Current subtree root.
-     * @param value Value to remove.
-     * @return Updated subtree root pointer.
+     * @brief Calls a traversal callable, treating a void result as "continue".
+     * @return False if the callable asked to stop.
      */
-    Node* deleteNode(Node* node, const T& value);
+    template <class Func>
+    static bool visit(Func& func, const T& value, std::true_type);
 
     /**
-     * @brief Recursively clones a subtree.
-     * @param node Root of the subtree to clone.
-     * @return New subtree root.
+     * @brief Calls a traversal callable that returns whether to continue.
+     * @return The callable's result.
      */
-    Node* copyTree(Node* node);
+    template <class Func>
+    static bool visit(Func& func, const T& value, std::false_type);
 };
 
 // --- Implementation ---
+//
+// Every operation is iterative: descents are loops and traversals keep
+// their pending nodes on an explicit stack, so a degenerate tree costs
+// heap rather than call-stack depth however many nodes it holds.
 
-template <class T>
-Bst<T>::Bst()
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>::Bst()
 {
     root = nullptr;
 }
 
-template <class T>
-Bst<T>::~Bst()
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>::~Bst()
 {
     deleteTree(root);
     root = nullptr;
 }
-template <class T>
-Bst<T>::Bst(const Bst& other)
+
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>::Bst(const Bst& other)
 {
     root = copyTree(other.root);
 }
 
-template <class T>
-typename Bst<T>::Node* Bst<T>::copyTree(Node* node)
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Node* Bst<T, Balance, Alloc, Augment>::copyTree(const Node* node)
 {
-    if (!node)
+    Node* copyRoot = nullptr;
+
+    // Each entry is a source node and the link its copy must be stored in
+    std::vector<std::pair<const Node*, Node**> > stack;
+    if (node)
     {
-        return nullptr;
+        stack.push_back(std::make_pair(node, &copyRoot));
+    }
+    while (!stack.empty())
+    {
+        const Node* from = stack.back().first;
+        Node** link = stack.back().second;
+        stack.pop_back();
+
+        Node* to = pool.Create(*from);
+        to->left = to->right = nullptr;
+        *link = to;
+
+        if (from->right)
+        {
+            stack.push_back(std::make_pair(from->right, &to->right));
+        }
+        if (from->left)
+        {
+            stack.push_back(std::make_pair(from->left, &to->left));
+        }
     }
-    Node* newNode = new Node{node->data, nullptr, nullptr};
-    newNode->left = copyTree(node->left);
-    newNode->right = copyTree(node->right);
-    return newNode;
+    return copyRoot;
 }
 
-template <class T>
-Bst<T>& Bst<T>::operator=(const Bst& other)
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>& Bst<T, Balance, Alloc, Augment>::operator=(const Bst& other)
 {
     if (this != &other)  // protect against self-assignment
     {
@@ -228,182 +500,724 @@ Bst<T>& Bst<T>::operator=(const Bst& other)
     return *this;
 }
 
-template <class T>
-void Bst<T>::Insert(const T& value)
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>::Bst(Bst&& other) noexcept
 {
-    root = insert(root, value);
+    root = other.root;
+    other.root = nullptr;
+    pool.Swap(other.pool);
 }
 
-template <class T>
-typename Bst<T>::Node* Bst<T>::insert(Node* node, const T& value)
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>& Bst<T, Balance, Alloc, Augment>::operator=(Bst&& other) noexcept
 {
-    if (node == nullptr)
+    if (this != &other)
     {
-        node = new Node{value, nullptr, nullptr};
+        // The emptied pool goes back to other, so it stays usable
+        deleteTree(root);
+        root = other.root;
+        other.root = nullptr;
+        pool.Swap(other.pool);
     }
-    else if (value < node->data)
+    return *this;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+bool Bst<T, Balance, Alloc, Augment>::Insert(const T& value)
+{
+    if (keepsPath)
     {
-        node->left = insert(node->left, value);
+        path.clear();
     }
-    else if (value > node->data)
+
+    Node** link = &root;
+    while (*link != nullptr)
     {
-        node->right = insert(node->right, value);
+        if (keepsPath)
+        {
+            path.push_back(link);
+        }
+
+        if (value < (*link)->data)
+        {
+            link = &(*link)->left;
+        }
+        else if (value > (*link)->data)
+        {
+            link = &(*link)->right;
+        }
+        else
+        {
+            return false;
+        }
     }
-    return node;
-}
 
-template <class T>
-bool Bst<T>::Search(const T& value) const
-{
-    return search(root, value);
+    *link = pool.Create(value);
+    (*link)->Refresh();
+    rebalancePath();
+    return true;
 }
 
-template <class T>
-bool Bst<T>::search(Node* node, const T& value) const
+template <class T, class Balance, class Alloc, class Augment>
+void Bst<T, Balance, Alloc, Augment>::rebalancePath()
 {
-    if (node == nullptr)
-    {
-        return false;
-    }
-    else if (value == node->data)
+    if (!keepsPath)
     {
-        return true;
+        return;
     }
-    else if (value < node->data)
+
+    // A rotation only rewrites the link it was called on, so the links
+    // recorded above it stay valid
+    for (size_t i = path.size(); i-- > 0; )
     {
-        return search(node->left, value);
+        if (Balance::rebalances)
+        {
+            *path[i] = Balance::Rebalance(*path[i]);
+        }
+        else
+        {
+            (*path[i])->Refresh();
+        }
     }
-    else
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+bool Bst<T, Balance, Alloc, Augment>::Search(const T& value) const
+{
+    const Node* node = root;
+    while (node != nullptr)
     {
-        return search(node->right, value);
+        if (value == node->data)
+        {
+            return true;
+        }
+        node = (value < node->data) ? node->left : node->right;
     }
+    return false;
 }
 
-template <class T>
-void Bst<T>::DeleteTree()
+template <class T, class Balance, class Alloc, class Augment>
+void Bst<T, Balance, Alloc, Augment>::DeleteTree()
 {
     deleteTree(root);
     root = nullptr;
 }
 
-template <class T>
-void Bst<T>::deleteTree(Node* node)
+template <class T, class Balance, class Alloc, class Augment>
+void Bst<T, Balance, Alloc, Augment>::deleteTree(Node* node)
 {
-    if (node)
+    typedef typename Alloc::template Pool<Node> NodePool;
+
+    // Nothing to run per node: hand every slab back at once
+    if (NodePool::releasesAll && std::is_trivially_destructible<Node>::value)
     {
-        deleteTree(node->left);
-        deleteTree(node->right);
-        delete node;
+        pool.ReleaseAll();
+        return;
     }
+
+    // Rotate left children up until the node has none, then free it and
+    // continue with its right subtree
+    while (node)
+    {
+        if (node->left)
+        {
+            Node* left = node->left;
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+        else
+        {
+            Node* right = node->right;
+            pool.Destroy(node);
+            node = right;
+        }
+    }
+    pool.ReleaseAll();
 }
 
-template <class T>
-void Bst<T>::DeleteNode(const T& value)
+template <class T, class Balance, class Alloc, class Augment>
+void Bst<T, Balance, Alloc, Augment>::DeleteNode(const T& value)
 {
-    root = deleteNode(root, value);
+    if (keepsPath)
+    {
+        path.clear();
+    }
+
+    Node** link = &root;
+    while (*link != nullptr && !(value == (*link)->data))
+    {
+        if (keepsPath)
+        {
+            path.push_back(link);
+        }
+        link = (value < (*link)->data) ? &(*link)->left : &(*link)->right;
+    }
+    if (*link == nullptr)
+    {
+        return;
+    }
+
+    // Two children: take the successor's value and remove the successor,
+    // which has no left child
+    Node* node = *link;
+    if (node->left != nullptr && node->right != nullptr)
+    {
+        if (keepsPath)
+        {
+            path.push_back(link);
+        }
+        link = &node->right;
+        while ((*link)->left != nullptr)
+        {
+            if (keepsPath)
+            {
+                path.push_back(link);
+            }
+            link = &(*link)->left;
+        }
+        node->data = (*link)->data;
+        node = *link;
+    }
+
+    // Now at most one child: splice it into the node's place
+    *link = (node->left != nullptr) ? node->left : node->right;
+    pool.Destroy(node);
+    rebalancePath();
 }
 
-template <class T>
-typename Bst<T>::Node* Bst<T>::deleteNode(Node* node, const T& value)
+template <class T, class Balance, class Alloc, class Augment>
+template <class Func>
+bool Bst<T, Balance, Alloc, Augment>::visit(Func& func, const T& value, std::true_type)
 {
-    if (node == nullptr)
+    func(value);
+    return true;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class Func>
+bool Bst<T, Balance, Alloc, Augment>::visit(Func& func, const T& value, std::false_type)
+{
+    return func(value);
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class Func>
+bool Bst<T, Balance, Alloc, Augment>::InOrder(Func func) const
+{
+    typedef std::is_void<decltype(func(std::declval<const T&>()))> ReturnsVoid;
+    std::vector<const Node*> stack;
+    const Node* node = root;
+    while (node != nullptr || !stack.empty())
     {
-        return nullptr;
+        while (node != nullptr)
+        {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        if (!visit(func, node->data, ReturnsVoid()))
+        {
+            return false;
+        }
+        node = node->right;
     }
+    return true;
+}
 
-    if (value < node->data)
+template <class T, class Balance, class Alloc, class Augment>
+template <class Func>
+bool Bst<T, Balance, Alloc, Augment>::PreOrder(Func func) const
+{
+    typedef std::is_void<decltype(func(std::declval<const T&>()))> ReturnsVoid;
+    std::vector<const Node*> stack;
+    if (root != nullptr)
     {
-        node->left = deleteNode(node->left, value);
+        stack.push_back(root);
     }
-    else if (value > node->data)
+    while (!stack.empty())
     {
-        node->right = deleteNode(node->right, value);
+        const Node* node = stack.back();
+        stack.pop_back();
+        if (!visit(func, node->data, ReturnsVoid()))
+        {
+            return false;
+        }
+
+        // Right first so the left subtree is visited first
+        if (node->right != nullptr)
+        {
+            stack.push_back(node->right);
+        }
+        if (node->left != nullptr)
+        {
+            stack.push_back(node->left);
+        }
     }
-    else
+    return true;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class Func>
+bool Bst<T, Balance, Alloc, Augment>::PostOrder(Func func) const
+{
+    typedef std::is_void<decltype(func(std::declval<const T&>()))> ReturnsVoid;
+    std::vector<const Node*> stack;
+    const Node* node = root;
+    const Node* last = nullptr;
+    while (node != nullptr || !stack.empty())
     {
-        // Case 1: Leaf
-        if (node->left == nullptr && node->right == nullptr)
+        if (node != nullptr)
         {
-            delete node;
-            node = nullptr;
+            stack.push_back(node);
+            node = node->left;
+            continue;
         }
-        // Case 2: One child
-        else if (node->left == nullptr)
+
+        // Visit the top once its right subtree is done
+        const Node* top = stack.back();
+        if (top->right != nullptr && top->right != last)
         {
-            Node* temp = node->right;
-            delete node;
-            node = temp;
+            node = top->right;
         }
-        else if (node->right == nullptr)
+        else
         {
-            Node* temp = node->left;
-            delete node;
-            node = temp;
+            if (!visit(func, top->data, ReturnsVoid()))
+            {
+                return false;
+            }
+            last = top;
+            stack.pop_back();
         }
-        // Case 3: Two children
-        else
+    }
+    return true;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class Visitor>
+bool Bst<T, Balance, Alloc, Augment>::VisitRange(const T& lo, const T& hi, Visitor visitor) const
+{
+    typedef std::is_void<decltype(visitor(std::declval<const T&>()))> ReturnsVoid;
+    std::vector<const Node*> stack;
+    const Node* node = root;
+    while (node != nullptr || !stack.empty())
+    {
+        // Go left, but skip any node below lo along with its left subtree
+        while (node != nullptr)
         {
-            Node* successor = node->right;
-            while (successor->left != nullptr)
+            if (node->data < lo)
+            {
+                node = node->right;
+            }
+            else
             {
-                successor = successor->left;
+                stack.push_back(node);
+                node = node->left;
             }
-            node->data = successor->data;
-            node->right = deleteNode(node->right, successor->data);
         }
+        if (stack.empty())
+        {
+            return true;
+        }
+
+        node = stack.back();
+        stack.pop_back();
+        if (node->data > hi)
+        {
+            return true;
+        }
+        if (!visit(visitor, node->data, ReturnsVoid()))
+        {
+            return false;
+        }
+        node = node->right;
     }
-    return node;
+    return true;
 }
 
-template <class T>
-void Bst<T>::InOrder(void (*func)(const T&)) const
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Iterator Bst<T, Balance, Alloc, Augment>::begin() const
 {
-    inOrder(root, func);
+    Iterator it;
+    it.m_root = root;
+    it.descend(root, true);
+    return it;
 }
 
-template <class T>
-void Bst<T>::inOrder(const Node* node,void (*func)(const T&)) const
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Iterator Bst<T, Balance, Alloc, Augment>::end() const
 {
-    if (node)
+    Iterator it;
+    it.m_root = root;
+    return it;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+Bst<T, Balance, Alloc, Augment>::Iterator::Iterator()
+    : m_root(nullptr)
+{
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+const T& Bst<T, Balance, Alloc, Augment>::Iterator::operator*() const
+{
+    return m_path.back()->data;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+const T* Bst<T, Balance, Alloc, Augment>::Iterator::operator->() const
+{
+    return &m_path.back()->data;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+void Bst<T, Balance, Alloc, Augment>::Iterator::descend(const Node* node, bool leftmost)
+{
+    while (node != nullptr)
+    {
+        m_path.push_back(node);
+        node = leftmost ? node->left : node->right;
+    }
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Iterator& Bst<T, Balance, Alloc, Augment>::Iterator::operator++()
+{
+    const Node* node = m_path.back();
+    if (node->right != nullptr)
     {
-        inOrder(node->left, func);
-        func(node->data);
-        inOrder(node->right, func);
+        descend(node->right, true);
+        return *this;
     }
+
+    // Climb until we leave a left subtree; its parent is next
+    const Node* child;
+    do
+    {
+        child = m_path.back();
+        m_path.pop_back();
+    }
+    while (!m_path.empty() && m_path.back()->right == child);
+    return *this;
 }
 
-template <class T>
-void Bst<T>::PreOrder(void (*func)(const T&)) const
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Iterator Bst<T, Balance, Alloc, Augment>::Iterator::operator++(int)
 {
-    preOrder(root, func);
+    Iterator old = *this;
+    ++*this;
+    return old;
 }
 
-template <class T>
-void Bst<T>::preOrder(const Node* node,void (*func)(const T&)) const
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Iterator& Bst<T, Balance, Alloc, Augment>::Iterator::operator--()
 {
-    if (node)
+    if (m_path.empty())
     {
-        func(node->data);
-        preOrder(node->left, func);
-        preOrder(node->right, func);
+        descend(m_root, false);
+        return *this;
     }
+
+    const Node* node = m_path.back();
+    if (node->left != nullptr)
+    {
+        descend(node->left, false);
+        return *this;
+    }
+
+    // Climb until we leave a right subtree; its parent is previous
+    const Node* child;
+    do
+    {
+        child = m_path.back();
+        m_path.pop_back();
+    }
+    while (!m_path.empty() && m_path.back()->left == child);
+    return *this;
 }
 
-template <class T>
-void Bst<T>::PostOrder(void (*func)(const T&)) const
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Iterator Bst<T, Balance, Alloc, Augment>::Iterator::operator--(int)
 {
-    postOrder(root, func);
+    Iterator old = *this;
+    --*this;
+    return old;
 }
 
-template <class T>
-void Bst<T>::postOrder(const Node* node,void (*func)(const T&)) const
+template <class T, class Balance, class Alloc, class Augment>
+bool Bst<T, Balance, Alloc, Augment>::Iterator::operator==(const Iterator& other) const
 {
-    if (node)
+    if (m_path.empty() || other.m_path.empty())
     {
-        postOrder(node->left, func);
-        postOrder(node->right, func);
-        func(node->data);
+        return m_path.empty() && other.m_path.empty();
+    }
+    return m_path.back() == other.m_path.back();
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+bool Bst<T, Balance, Alloc, Augment>::Iterator::operator!=(const Iterator& other) const
+{
+    return !(*this == other);
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+int Bst<T, Balance, Alloc, Augment>::GetHeight() const
+{
+    int height = 0;
+    std::vector<std::pair<const Node*, int> > stack;
+    if (root != nullptr)
+    {
+        stack.push_back(std::make_pair(root, 1));
+    }
+    while (!stack.empty())
+    {
+        const Node* node = stack.back().first;
+        int depth = stack.back().second;
+        stack.pop_back();
+
+        if (depth > height)
+        {
+            height = depth;
+        }
+        if (node->left != nullptr)
+        {
+            stack.push_back(std::make_pair(node->left, depth + 1));
+        }
+        if (node->right != nullptr)
+        {
+            stack.push_back(std::make_pair(node->right, depth + 1));
+        }
+    }
+    return height;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+void Bst<T, Balance, Alloc, Augment>::Compact()
+{
+    std::vector<T> values(begin(), end());
+    deleteTree(root);
+    root = nullptr;
+    BuildFromSorted(values.begin(), values.end());
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class Iter>
+int Bst<T, Balance, Alloc, Augment>::BuildFromSorted(Iter first, Iter last)
+{
+    int duplicates = 0;
+    if (!std::is_sorted(first, last))
+    {
+        for (; first != last; ++first)
+        {
+            duplicates += Insert(*first) ? 0 : 1;
+        }
+        return duplicates;
+    }
+
+    // Take the current values out, in order, to merge with the run
+    std::vector<T> existing;
+    for (Iterator it = begin(); it != end(); ++it)
+    {
+        existing.push_back(*it);
+    }
+    deleteTree(root);
+    root = nullptr;
+
+    // Create the merged nodes in sorted order, so they are laid out in
+    // order. Existing values win over equal ones from the run.
+    size_t total = existing.size() + std::distance(first, last);
+    std::vector<Node*> nodes;
+    nodes.reserve(total);
+    pool.Reserve(static_cast<int>(total));
+    size_t next = 0;
+    for (; first != last; ++first)
+    {
+        while (next < existing.size() && existing[next] < *first)
+        {
+            nodes.push_back(pool.Create(existing[next++]));
+        }
+        if ((next < existing.size() && !(*first < existing[next])) ||
+            (!nodes.empty() && !(nodes.back()->data < *first)))
+        {
+            duplicates++;
+            continue;
+        }
+        nodes.push_back(pool.Create(*first));
+    }
+    while (next < existing.size())
+    {
+        nodes.push_back(pool.Create(existing[next++]));
+    }
+
+    root = linkBalanced(nodes);
+    return duplicates;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+typename Bst<T, Balance, Alloc, Augment>::Node* Bst<T, Balance, Alloc, Augment>::linkBalanced(const std::vector<Node*>& nodes)
+{
+    // Link each range's middle node as the root of that range
+    struct Range
+    {
+        int first;
+        int last;
+        Node** link;
+    };
+    Node* newRoot = nullptr;
+    std::vector<Range> ranges;
+    std::vector<Node*> linked;
+    Range all = {0, static_cast<int>(nodes.size()) - 1, &newRoot};
+    ranges.push_back(all);
+    while (!ranges.empty())
+    {
+        Range range = ranges.back();
+        ranges.pop_back();
+        if (range.first > range.last)
+        {
+            continue;
+        }
+
+        int mid = range.first + (range.last - range.first) / 2;
+        Node* middle = nodes[mid];
+        *range.link = middle;
+        linked.push_back(middle);
+
+        Range left = {range.first, mid - 1, &middle->left};
+        Range right = {mid + 1, range.last, &middle->right};
+        ranges.push_back(left);
+        ranges.push_back(right);
+    }
+
+    // Parents were linked before their children, so walking backwards
+    // lets the policies set up their node data bottom-up. The tree is
+    // already balanced, so no rotations happen.
+    if (keepsPath)
+    {
+        for (size_t i = linked.size(); i-- > 0; )
+        {
+            if (Balance::rebalances)
+            {
+                Balance::Rebalance(linked[i]);
+            }
+            else
+            {
+                linked[i]->Refresh();
+            }
+        }
+    }
+    return newRoot;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class A>
+typename A::Summary Bst<T, Balance, Alloc, Augment>::Summarize(const T& lo, const T& hi) const
+{
+    typename A::Summary summary;
+
+    // Find the highest node in range; both bounds split below it
+    const Node* split = root;
+    while (split != nullptr && (split->data < lo || split->data > hi))
+    {
+        split = (split->data < lo) ? split->right : split->left;
+    }
+    if (split == nullptr)
+    {
+        return summary;
+    }
+    A::AddNode(summary, split);
+
+    // Down the left side: a node at or above lo brings its right subtree
+    const Node* node = split->left;
+    while (node != nullptr)
+    {
+        if (node->data < lo)
+        {
+            node = node->right;
+        }
+        else
+        {
+            A::AddNode(summary, node);
+            A::AddSubtree(summary, node->right);
+            node = node->left;
+        }
+    }
+
+    // Down the right side: a node at or below hi brings its left subtree
+    node = split->right;
+    while (node != nullptr)
+    {
+        if (node->data > hi)
+        {
+            node = node->left;
+        }
+        else
+        {
+            A::AddNode(summary, node);
+            A::AddSubtree(summary, node->left);
+            node = node->right;
+        }
+    }
+    return summary;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+template <class A>
+typename A::Summary Bst<T, Balance, Alloc, Augment>::Summarize() const
+{
+    typename A::Summary summary;
+    A::AddSubtree(summary, static_cast<const Node*>(root));
+    return summary;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+int Bst<T, Balance, Alloc, Augment>::GetSize() const
+{
+    return root ? root->size : 0;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+const T* Bst<T, Balance, Alloc, Augment>::Select(int k) const
+{
+    const Node* node = root;
+    while (node != nullptr)
+    {
+        int leftSize = node->left ? node->left->size : 0;
+        if (k < leftSize)
+        {
+            node = node->left;
+        }
+        else if (k == leftSize)
+        {
+            return &node->data;
+        }
+        else
+        {
+            k -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    return nullptr;
+}
+
+template <class T, class Balance, class Alloc, class Augment>
+int Bst<T, Balance, Alloc, Augment>::Rank(const T& value) const
+{
+    int rank = 0;
+    const Node* node = root;
+    while (node != nullptr)
+    {
+        if (node->data < value)
+        {
+            rank += 1 + (node->left ? node->left->size : 0);
+            node = node->right;
+        }
+        else
+        {
+            node = node->left;
+        }
     }
+    return rank;
 }
 
 #endif // BST_H_INCLUDED
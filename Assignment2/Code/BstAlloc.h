@@ -0,0 +1,211 @@
+#ifndef BSTALLOC_H_INCLUDED
+#define BSTALLOC_H_INCLUDED
+
+#include <new>
+#include <utility>
+#include <vector>
+#include <type_traits>
+
+/**
+ * @file BstAlloc.h
+ * @brief Node allocation policies for the Bst template.
+ *
+ * A policy provides a class template Pool<Node>, one instance per tree,
+ * with:
+ *   - Create(args...): constructs a node and returns it.
+ *   - Destroy(node): destroys one node created by this pool.
+ *   - Reserve(count): hint that @p count nodes are about to be created
+ *     together, so they can be placed next to each other.
+ *   - ReleaseAll(): frees every node's memory at once, without running
+ *     destructors; only meaningful when releasesAll is true.
+ *   - releasesAll: true if ReleaseAll() actually frees the nodes, so Bst
+ *     can skip per-node deletion when nodes are trivially destructible.
+ *
+ * Pools are never copied: a copied tree allocates from a fresh pool, and a
+ * moved tree swaps pools with the tree it came from.
+ */
+
+/**
+ * @struct BstHeap
+ * @brief Every node is a separate new/delete (the original behaviour).
+ */
+struct BstHeap
+{
+    template <class Node>
+    class Pool
+    {
+    public:
+        static const bool releasesAll = false; ///< Nodes must be deleted one by one.
+
+        Pool()
+        {
+        }
+
+        /** @brief Allocates and constructs one node. */
+        template <class... Args>
+        Node* Create(Args&&... args)
+        {
+            return new Node(std::forward<Args>(args)...);
+        }
+
+        /** @brief Destroys and frees one node. */
+        void Destroy(Node* node)
+        {
+            delete node;
+        }
+
+        /** @brief No effect; every node is a separate allocation. */
+        void Reserve(int)
+        {
+        }
+
+        /** @brief Nothing to release; nodes are freed individually. */
+        void ReleaseAll()
+        {
+        }
+
+        /** @brief Exchanges contents with another pool (stateless here). */
+        void Swap(Pool&) noexcept
+        {
+        }
+
+    private:
+        Pool(const Pool&);
+        Pool& operator=(const Pool&);
+    };
+};
+
+/**
+ * @struct BstArena
+ * @brief Nodes are carved in order out of large slabs owned by the tree.
+ *
+ * Creating a node is a pointer bump (or a pop from the free list of
+ * deleted nodes), consecutive inserts sit next to each other in memory,
+ * and ReleaseAll() frees the whole tree with one delete per slab. Slabs
+ * start small so that small trees stay small, and double up to
+ * BstArena::MAX_SLAB_NODES nodes.
+ */
+struct BstArena
+{
+    static const int FIRST_SLAB_NODES = 32;   ///< Nodes in a pool's first slab.
+    static const int MAX_SLAB_NODES = 4096;   ///< Slabs stop growing at this size.
+
+    template <class Node>
+    class Pool
+    {
+    public:
+        static const bool releasesAll = true; ///< ReleaseAll() frees every node.
+
+        Pool()
+            : m_free(nullptr), m_next(nullptr), m_end(nullptr), m_slabNodes(FIRST_SLAB_NODES)
+        {
+        }
+
+        ~Pool()
+        {
+            ReleaseAll();
+        }
+
+        /** @brief Constructs a node in the next free slot. */
+        template <class... Args>
+        Node* Create(Args&&... args)
+        {
+            Slot* slot;
+            if (m_free != nullptr)
+            {
+                slot = m_free;
+                m_free = m_free->next;
+            }
+            else
+            {
+                if (m_next == m_end)
+                {
+                    AddSlab();
+                }
+                slot = m_next++;
+            }
+            return new (static_cast<void*>(slot)) Node(std::forward<Args>(args)...);
+        }
+
+        /** @brief Destroys a node and keeps its slot for the next Create(). */
+        void Destroy(Node* node)
+        {
+            node->~Node();
+            Slot* slot = reinterpret_cast<Slot*>(node);
+            slot->next = m_free;
+            m_free = slot;
+        }
+
+        /**
+         * @brief Makes the next @p count Create() calls fill one slab.
+         *
+         * Starts a slab of at least @p count nodes if the current one has
+         * less room. Slots of destroyed nodes are still reused first.
+         */
+        void Reserve(int count)
+        {
+            if (m_end - m_next < count)
+            {
+                AddSlab(count);
+            }
+        }
+
+        /** @brief Frees every slab. Destructors are not run. */
+        void ReleaseAll()
+        {
+            for (size_t i = 0; i < m_slabs.size(); i++)
+            {
+                ::operator delete(m_slabs[i]);
+            }
+            m_slabs.clear();
+            m_free = m_next = m_end = nullptr;
+            m_slabNodes = FIRST_SLAB_NODES;
+        }
+
+        /** @brief Exchanges slabs with another pool. */
+        void Swap(Pool& other) noexcept
+        {
+            m_slabs.swap(other.m_slabs);
+            std::swap(m_free, other.m_free);
+            std::swap(m_next, other.m_next);
+            std::swap(m_end, other.m_end);
+            std::swap(m_slabNodes, other.m_slabNodes);
+        }
+
+    private:
+        /** @brief Storage for one node, or a link while the slot is free. */
+        union Slot
+        {
+            Slot* next;
+            typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+        };
+
+        std::vector<Slot*> m_slabs; ///< Every slab allocated, to free them.
+        Slot* m_free;               ///< Slots of destroyed nodes.
+        Slot* m_next;               ///< Next unused slot in the newest slab.
+        Slot* m_end;                ///< One past the newest slab.
+        int m_slabNodes;            ///< Size of the next slab.
+
+        /**
+         * @brief Starts a new slab, twice as large as the last one.
+         * @param minNodes Smallest slab acceptable.
+         */
+        void AddSlab(int minNodes = 0)
+        {
+            int nodes = (minNodes > m_slabNodes) ? minNodes : m_slabNodes;
+            Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * nodes));
+            m_slabs.push_back(slab);
+            m_next = slab;
+            m_end = slab + nodes;
+            if (m_slabNodes < MAX_SLAB_NODES)
+            {
+                m_slabNodes *= 2;
+            }
+        }
+
+        Pool(const Pool&);
+        Pool& operator=(const Pool&);
+    };
+};
+
+#endif // BSTALLOC_H_INCLUDED
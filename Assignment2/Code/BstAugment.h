@@ -0,0 +1,224 @@
+#ifndef BSTAUGMENT_H_INCLUDED
+#define BSTAUGMENT_H_INCLUDED
+
+#include <cmath>
+
+/**
+ * @file BstAugment.h
+ * @brief Augmentation policies for the Bst template.
+ *
+ * An augmentation caches, in every node, something computed from the
+ * node's value and its children's cached data. A policy supplies:
+ *   - NodeBase: the cached fields, inherited by Bst's Node.
+ *   - augments: false if there is nothing to maintain, so Bst can skip
+ *     the walk back up to the root.
+ *   - Update(node): recomputes @p node's fields from its value and its
+ *     children's fields. Bst (and the balancing policy, after a rotation)
+ *     calls it bottom-up on every node whose subtree changed.
+ *
+ * A policy that can summarise a range also supplies a Summary type and
+ * AddNode(summary, node) / AddSubtree(summary, node), used by
+ * Bst::Summarize.
+ */
+
+/**
+ * @struct BstPlain
+ * @brief No augmentation (the original behaviour).
+ */
+struct BstPlain
+{
+    /** @brief No per-node data. */
+    struct NodeBase
+    {
+    };
+
+    static const bool augments = false; ///< Update is a no-op.
+
+    /** @brief Nothing to recompute. */
+    template <class Node>
+    static void Update(Node*)
+    {
+    }
+};
+
+/**
+ * @struct BstSize
+ * @brief Order statistics: every node knows how many nodes its subtree holds.
+ *
+ * Enables Bst::Select (the k-th smallest value) and Bst::Rank (how many
+ * values are smaller) in O(height). Costs one int per node.
+ */
+struct BstSize
+{
+    /** @brief Number of nodes in the subtree rooted at the node. */
+    struct NodeBase
+    {
+        int size; ///< Subtree size, 1 for a leaf.
+
+        NodeBase()
+            : size(1)
+        {
+        }
+    };
+
+    static const bool augments = true; ///< Sizes follow every change.
+
+    /**
+     * @brief Size of a subtree, 0 for an empty one.
+     */
+    template <class Node>
+    static int Size(const Node* node)
+    {
+        return node ? node->size : 0;
+    }
+
+    /**
+     * @brief Recomputes a node's subtree size from its children.
+     */
+    template <class Node>
+    static void Update(Node* node)
+    {
+        node->size = 1 + Size(node->left) + Size(node->right);
+    }
+};
+
+/**
+ * @struct BstAggregate
+ * @brief Subtree count, sum and sum of squares of numeric fields of the values.
+ *
+ * Every node caches, for its whole subtree, the number of values and the
+ * sum and sum of squares of each field, so Bst::Summarize returns the
+ * count, mean and SD of every field over any range of values in
+ * O(height) without visiting the values in between. Subtree sizes are
+ * included, so Select and Rank work too.
+ *
+ * Sums are doubles; the variance is computed from them as
+ * (sumSq - sum^2 / n) / (n - 1).
+ *
+ * @tparam Fields Traits with @c static const int count, the number of
+ *         fields, and @c static double Get(const T& value, int field).
+ */
+template <class Fields>
+struct BstAggregate
+{
+    /**
+     * @struct Summary
+     * @brief Count, sums and sums of squares of a set of values.
+     */
+    struct Summary
+    {
+        int size;                   ///< Number of values.
+        double sum[Fields::count];   ///< Sum of each field.
+        double sumSq[Fields::count]; ///< Sum of the squares of each field.
+
+        /** @brief An empty set. */
+        Summary()
+            : size(0)
+        {
+            for (int f = 0; f < Fields::count; f++)
+            {
+                sum[f] = sumSq[f] = 0.0;
+            }
+        }
+
+        /** @brief Adds one value. */
+        template <class T>
+        void AddValue(const T& value)
+        {
+            size++;
+            for (int f = 0; f < Fields::count; f++)
+            {
+                double x = Fields::Get(value, f);
+                sum[f] += x;
+                sumSq[f] += x * x;
+            }
+        }
+
+        /** @brief Adds another, disjoint, set. */
+        void Add(const Summary& other)
+        {
+            size += other.size;
+            for (int f = 0; f < Fields::count; f++)
+            {
+                sum[f] += other.sum[f];
+                sumSq[f] += other.sumSq[f];
+            }
+        }
+
+        /** @brief Number of values. */
+        int GetCount() const
+        {
+            return size;
+        }
+
+        /** @brief Sum of a field. */
+        double GetSum(int field) const
+        {
+            return sum[field];
+        }
+
+        /** @brief Mean of a field, 0 for an empty set. */
+        double GetMean(int field) const
+        {
+            return (size > 0) ? sum[field] / size : 0.0;
+        }
+
+        /** @brief Sample standard deviation of a field, 0 for fewer than two values. */
+        double GetSd(int field) const
+        {
+            if (size < 2)
+            {
+                return 0.0;
+            }
+            double variance = (sumSq[field] - sum[field] * sum[field] / size) / (size - 1);
+            return (variance > 0.0) ? std::sqrt(variance) : 0.0;
+        }
+    };
+
+    /** @brief The subtree's Summary; a node is its own one-value set until updated. */
+    struct NodeBase : public Summary
+    {
+        NodeBase()
+        {
+            Summary::size = 1;
+        }
+    };
+
+    static const bool augments = true; ///< Aggregates follow every change.
+
+    /**
+     * @brief Recomputes a node's aggregates from its value and children.
+     */
+    template <class Node>
+    static void Update(Node* node)
+    {
+        Summary& total = *node;
+        total = Summary();
+        total.AddValue(node->data);
+        AddSubtree(total, node->left);
+        AddSubtree(total, node->right);
+    }
+
+    /**
+     * @brief Adds a node's own value, not its subtree.
+     */
+    template <class Node>
+    static void AddNode(Summary& summary, const Node* node)
+    {
+        summary.AddValue(node->data);
+    }
+
+    /**
+     * @brief Adds a whole subtree from its cached aggregates; null adds nothing.
+     */
+    template <class Node>
+    static void AddSubtree(Summary& summary, const Node* node)
+    {
+        if (node != nullptr)
+        {
+            summary.Add(*node);
+        }
+    }
+};
+
+#endif // BSTAUGMENT_H_INCLUDED
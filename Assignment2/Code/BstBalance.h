@@ -0,0 +1,167 @@
+#ifndef BSTBALANCE_H_INCLUDED
+#define BSTBALANCE_H_INCLUDED
+
+/**
+ * @file BstBalance.h
+ * @brief Balancing policies for the Bst template.
+ *
+ * A policy supplies three things:
+ *   - NodeBase: extra per-node fields, inherited by Bst's Node.
+ *   - rebalances: false if Rebalance never changes anything, so Bst can
+ *     skip the walk back up to the root.
+ *   - Rebalance(node): called on every node along the path of an insert
+ *     or delete, bottom-up, once its subtrees are final. It returns the
+ *     node that should take @p node's place in the tree.
+ *
+ * Node types used with a policy must expose @c left and @c right child
+ * pointers, and a Refresh() member that recomputes any augmented data
+ * (see BstAugment.h) from the children. A policy that rotates calls it
+ * on every node whose children it changes, bottom-up.
+ */
+
+/**
+ * @struct BstUnbalanced
+ * @brief Plain BST: no extra node fields and no rotations.
+ *
+ * Shape depends entirely on insertion order, so sorted input degrades the
+ * tree into a chain. This is the default and matches the original Bst.
+ */
+struct BstUnbalanced
+{
+    /** @brief No per-node data. */
+    struct NodeBase
+    {
+    };
+
+    static const bool rebalances = false; ///< Rebalance is a no-op.
+
+    /**
+     * @brief Leaves the subtree unchanged.
+     * @param node Subtree root.
+     * @return @p node.
+     */
+    template <class Node>
+    static Node* Rebalance(Node* node)
+    {
+        return node;
+    }
+};
+
+/**
+ * @struct BstAvl
+ * @brief AVL balancing: sibling subtree heights never differ by more than one.
+ *
+ * Keeps the tree height below about 1.44 log2(n), so Insert, Search and
+ * DeleteNode are O(log n) whatever the order values arrive in. Costs one
+ * int per node and at most two rotations per visited node.
+ */
+struct BstAvl
+{
+    /** @brief Height of the subtree rooted at the node (a leaf is 1). */
+    struct NodeBase
+    {
+        int height; ///< Subtree height.
+
+        NodeBase()
+            : height(1)
+        {
+        }
+    };
+
+    static const bool rebalances = true; ///< Rebalance may rotate.
+
+    /**
+     * @brief Restores the AVL property at @p node.
+     *
+     * Both subtrees of @p node must already be AVL trees whose heights
+     * differ by at most two, which holds after a single insert or delete.
+     *
+     * @param node Subtree root, may be null.
+     * @return New subtree root.
+     */
+    template <class Node>
+    static Node* Rebalance(Node* node)
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+
+        Update(node);
+        int balance = Height(node->left) - Height(node->right);
+
+        if (balance > 1)
+        {
+            // Left-right case: straighten the left child first
+            if (Height(node->left->left) < Height(node->left->right))
+            {
+                node->left = RotateLeft(node->left);
+            }
+            return RotateRight(node);
+        }
+        if (balance < -1)
+        {
+            // Right-left case: straighten the right child first
+            if (Height(node->right->right) < Height(node->right->left))
+            {
+                node->right = RotateRight(node->right);
+            }
+            return RotateLeft(node);
+        }
+        return node;
+    }
+
+private:
+    /**
+     * @brief Height of a subtree, 0 for an empty one.
+     */
+    template <class Node>
+    static int Height(const Node* node)
+    {
+        return node ? node->height : 0;
+    }
+
+    /**
+     * @brief Recomputes a node's height and augmented data from its children.
+     */
+    template <class Node>
+    static void Update(Node* node)
+    {
+        int left = Height(node->left);
+        int right = Height(node->right);
+        node->height = 1 + (left > right ? left : right);
+        node->Refresh();
+    }
+
+    /**
+     * @brief Rotates @p node's right child above it.
+     * @return New subtree root.
+     */
+    template <class Node>
+    static Node* RotateLeft(Node* node)
+    {
+        Node* pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        Update(node);
+        Update(pivot);
+        return pivot;
+    }
+
+    /**
+     * @brief Rotates @p node's left child above it.
+     * @return New subtree root.
+     */
+    template <class Node>
+    static Node* RotateRight(Node* node)
+    {
+        Node* pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        Update(node);
+        Update(pivot);
+        return pivot;
+    }
+};
+
+#endif // BSTBALANCE_H_INCLUDED
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "Bst.h"
+using namespace std;
+
+// The recursive algorithms Bst used before it became iterative, kept
+// here as the baseline the iterative versions are timed against
+template <class T>
+class RecursiveBst
+{
+public:
+    RecursiveBst() : root(nullptr) {}
+    ~RecursiveBst() { destroy(root); }
+
+    RecursiveBst(const RecursiveBst& other) : root(copy(other.root)) {}
+
+    void Insert(const T& value) { root = insert(root, value); }
+    bool Search(const T& value) const { return search(root, value); }
+    void DeleteNode(const T& value) { root = remove(root, value); }
+    void InOrder(void (*func)(const T&)) const { inOrder(root, func); }
+
+private:
+    struct Node
+    {
+        T data;
+        Node* left;
+        Node* right;
+    };
+
+    Node* root;
+
+    Node* insert(Node* node, const T& value)
+    {
+        if (node == nullptr)
+        {
+            return new Node{value, nullptr, nullptr};
+        }
+        if (value < node->data)
+        {
+            node->left = insert(node->left, value);
+        }
+        else if (value > node->data)
+        {
+            node->right = insert(node->right, value);
+        }
+        return node;
+    }
+
+    bool search(const Node* node, const T& value) const
+    {
+        if (node == nullptr)
+        {
+            return false;
+        }
+        if (value == node->data)
+        {
+            return true;
+        }
+        return search(value < node->data ? node->left : node->right, value);
+    }
+
+    Node* remove(Node* node, const T& value)
+    {
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+        if (value < node->data)
+        {
+            node->left = remove(node->left, value);
+        }
+        else if (value > node->data)
+        {
+            node->right = remove(node->right, value);
+        }
+        else if (node->left == nullptr || node->right == nullptr)
+        {
+            Node* child = node->left ? node->left : node->right;
+            delete node;
+            return child;
+        }
+        else
+        {
+            Node* successor = node->right;
+            while (successor->left != nullptr)
+            {
+                successor = successor->left;
+            }
+            node->data = successor->data;
+            node->right = remove(node->right, successor->data);
+        }
+        return node;
+    }
+
+    void inOrder(const Node* node, void (*func)(const T&)) const
+    {
+        if (node)
+        {
+            inOrder(node->left, func);
+            func(node->data);
+            inOrder(node->right, func);
+        }
+    }
+
+    Node* copy(const Node* node)
+    {
+        if (!node)
+        {
+            return nullptr;
+        }
+        Node* newNode = new Node{node->data, nullptr, nullptr};
+        newNode->left = copy(node->left);
+        newNode->right = copy(node->right);
+        return newNode;
+    }
+
+    void destroy(Node* node)
+    {
+        if (node)
+        {
+            destroy(node->left);
+            destroy(node->right);
+            delete node;
+        }
+    }
+};
+
+// Sum of visited values, so traversals cannot be optimised away
+long long g_sum = 0;
+
+// Traversal callback
+void AddValue(const int& x)
+{
+    g_sum += x;
+}
+
+// Milliseconds since start
+double ElapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Times insert, search, in-order, copy, delete and destruction on one tree type
+template <class Tree>
+void Run(const string& name, const vector<int>& values)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Tree* tree = new Tree;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        tree->Insert(values[i]);
+    }
+    double insertMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    int found = 0;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        found += tree->Search(values[i]) ? 1 : 0;
+    }
+    double searchMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    g_sum = 0;
+    tree->InOrder(AddValue);
+    double inOrderMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    Tree* copy = new Tree(*tree);
+    double copyMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < values.size(); i += 2)
+    {
+        tree->DeleteNode(values[i]);
+    }
+    double deleteMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    delete tree;
+    delete copy;
+    double destroyMs = ElapsedMs(start);
+
+    cout << name
+         << " | insert " << insertMs << " ms"
+         << " | search " << searchMs << " ms (" << found << " found)"
+         << " | in-order " << inOrderMs << " ms"
+         << " | copy " << copyMs << " ms"
+         << " | delete half " << deleteMs << " ms"
+         << " | destroy " << destroyMs << " ms" << endl;
+}
+
+// Runs one tree type, or all of them if name is empty
+void RunSelected(const string& name, const vector<int>& values)
+{
+    if (name.empty() || name == "recursive")
+    {
+        Run<RecursiveBst<int> >("recursive    ", values);
+    }
+    if (name.empty() || name == "iterative")
+    {
+        Run<Bst<int> >("iterative    ", values);
+    }
+    if (name.empty() || name == "avl")
+    {
+        Run<Bst<int, BstAvl> >("iterative AVL", values);
+    }
+    if (name.empty() || name == "arena")
+    {
+        Run<Bst<int, BstUnbalanced, BstArena> >("arena        ", values);
+    }
+    if (name.empty() || name == "arena-avl")
+    {
+        Run<Bst<int, BstAvl, BstArena> >("arena AVL    ", values);
+    }
+}
+
+// Usage: BstBench [recursive|iterative|avl|arena|arena-avl]
+// Trees freed by one run leave the heap fragmented for the next, which
+// skews later timings; pass a name to time one tree type per process.
+int main(int argc, char* argv[])
+{
+    string name = (argc > 1) ? argv[1] : "";
+    const int count = 1000000;
+    vector<int> values(count);
+    srand(2024);
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = (rand() << 15) ^ rand();
+    }
+
+    cout << "=== " << count << " random ints ===\n";
+    RunSelected(name, values);
+
+    // Sorted input: a chain for the unbalanced trees. Kept short enough
+    // that the recursive baseline does not overflow the stack.
+    const int chain = 20000;
+    vector<int> sorted(chain);
+    for (int i = 0; i < chain; i++)
+    {
+        sorted[i] = i;
+    }
+
+    cout << "\n=== " << chain << " sorted ints ===\n";
+    RunSelected(name, sorted);
+    return 0;
+}
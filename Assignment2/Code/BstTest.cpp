@@ -1,6 +1,10 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <set>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
 #include "Bst.h"
 using namespace std;
 
@@ -73,13 +77,14 @@ void TestDuplicateInsert()
     cout << "\n=== TestDuplicateInsert ===\n";
     Bst<int> tree;
 
-    tree.Insert(5);
-    tree.Insert(5); // duplicate should be ignored
+    bool first = tree.Insert(5);
+    bool second = tree.Insert(5); // duplicate should be ignored
 
     ResetVisited();
     tree.InOrder(Collect);
 
     Assert(visited.size() == 1, "Duplicate insertion ignored");
+    Assert(first && !second, "Insert reports whether the value was added");
 }
 
 // Verifies that InOrder traversal outputs sorted order
@@ -277,6 +282,45 @@ void TestAssignmentOperator()
     Assert(b.Search(1), "Deep copy unaffected by modifications");
 }
 
+// Ensures moves hand the nodes over and leave the source empty but usable
+void TestMove()
+{
+    cout << "\n=== TestMove ===\n";
+    Bst<int> a;
+    for (int x :
+            {
+                5, 3, 7
+            })
+    {
+        a.Insert(x);
+    }
+
+    Bst<int> b(std::move(a));
+    Assert(b.Search(3) && b.Search(7), "Moved-to tree has the values");
+    Assert(a.GetHeight() == 0 && !a.Search(5), "Moved-from tree is empty");
+    a.Insert(1);
+    Assert(a.Search(1) && !b.Search(1), "Moved-from tree reusable");
+
+    // Arena nodes live in the pool, so the pool must move with them
+    typedef Bst<int, BstAvl, BstArena, BstSize> Tree;
+    Tree c, d;
+    for (int i = 0; i < 1000; i++)
+    {
+        c.Insert(i);
+    }
+    d.Insert(-1);
+    d = std::move(c);
+    Assert(d.GetSize() == 1000 && *d.Select(999) == 999 && !d.Search(-1), "Move assignment replaces contents");
+    Assert(c.GetSize() == 0, "Move-assigned-from tree is empty");
+    c.Insert(42);
+    d.DeleteTree();
+    Assert(c.Search(42) && c.GetSize() == 1, "Moved-from arena tree reusable");
+
+    Tree& alias = d;
+    d = std::move(alias);
+    Assert(d.GetSize() == 0, "Self move assignment is harmless");
+}
+
 // Ensures BST invariant is valid after standard insertions
 void TestInvariantChecker()
 {
@@ -292,6 +336,496 @@ void TestInvariantChecker()
     }
 }
 
+// Verifies that sorted input chains a plain BST but not an AVL tree
+void TestAvlSortedInsert()
+{
+    cout << "\n=== TestAvlSortedInsert ===\n";
+    Bst<int> plain;
+    Bst<int, BstAvl> avl;
+
+    for (int i = 1; i <= 1023; i++)
+    {
+        plain.Insert(i);
+        avl.Insert(i);
+    }
+
+    Assert(plain.GetHeight() == 1023, "Plain BST degrades into a chain");
+    Assert(avl.GetHeight() == 10, "AVL tree of 1023 sorted values is perfectly balanced");
+    Assert(avl.Search(1) && avl.Search(512) && avl.Search(1023), "AVL search finds values");
+    Assert(!avl.Insert(512), "AVL duplicate insert ignored");
+
+    ResetVisited();
+    avl.InOrder(Collect);
+    bool sorted = visited.size() == 1023;
+    for (size_t i = 1; i < visited.size(); i++)
+    {
+        sorted = sorted && visited[i - 1] < visited[i];
+    }
+    Assert(sorted, "AVL in-order traversal sorted");
+}
+
+// Verifies that an AVL tree stays balanced and correct through deletions
+void TestAvlDelete()
+{
+    cout << "\n=== TestAvlDelete ===\n";
+    Bst<int, BstAvl> avl;
+
+    // Insert 0..999 in a scrambled order (7 and 1000 are coprime)
+    for (int i = 0; i < 1000; i++)
+    {
+        avl.Insert((i * 7) % 1000);
+    }
+
+    // Delete a prefix of the values so rotations happen on the left side
+    for (int i = 0; i < 600; i++)
+    {
+        avl.DeleteNode(i);
+    }
+
+    Assert(!avl.Search(0) && !avl.Search(599), "Deleted values gone");
+    Assert(avl.Search(600) && avl.Search(999), "Remaining values kept");
+    Assert(avl.GetHeight() <= 12, "Height stays within the AVL bound for 400 nodes");
+
+    ResetVisited();
+    avl.InOrder(Collect);
+    Assert(visited.size() == 400 && visited.front() == 600 && visited.back() == 999,
+           "In-order traversal holds exactly the remaining values");
+
+    Bst<int, BstAvl> copy(avl);
+    Assert(copy.GetHeight() == avl.GetHeight() && copy.Search(750), "Copy keeps shape and values");
+}
+
+// Compares random inserts and deletes against std::set
+template <class Tree>
+bool MatchesSet(unsigned int seed)
+{
+    Tree tree;
+    set<int> reference;
+    srand(seed);
+
+    for (int step = 0; step < 20000; step++)
+    {
+        int value = rand() % 2000;
+        if (rand() % 3 == 0)
+        {
+            tree.DeleteNode(value);
+            reference.erase(value);
+        }
+        else if (tree.Insert(value) != reference.insert(value).second)
+        {
+            return false;
+        }
+    }
+
+    ResetVisited();
+    tree.InOrder(Collect);
+    if (visited != vector<int>(reference.begin(), reference.end()) ||
+        !equal(tree.begin(), tree.end(), reference.begin()))
+    {
+        return false;
+    }
+
+    // A copy must traverse identically in every order
+    Tree copy(tree);
+    vector<int> pre, post, copyPre, copyPost;
+    ResetVisited();
+    tree.PreOrder(Collect);
+    pre = visited;
+    ResetVisited();
+    tree.PostOrder(Collect);
+    post = visited;
+    ResetVisited();
+    copy.PreOrder(Collect);
+    copyPre = visited;
+    ResetVisited();
+    copy.PostOrder(Collect);
+    copyPost = visited;
+    return pre.size() == reference.size() && pre == copyPre && post == copyPost;
+}
+
+// Verifies both policies against std::set under random inserts and deletes
+void TestRandomOperations()
+{
+    cout << "\n=== TestRandomOperations ===\n";
+    Assert(MatchesSet<Bst<int> >(17), "Plain BST matches std::set");
+    Assert(MatchesSet<Bst<int, BstAvl> >(17), "AVL tree matches std::set");
+    Assert(MatchesSet<Bst<int, BstUnbalanced, BstArena> >(17), "Arena BST matches std::set");
+    Assert(MatchesSet<Bst<int, BstAvl, BstArena> >(17), "Arena AVL tree matches std::set");
+    Assert(MatchesSet<Bst<int, BstUnbalanced, BstHeap, BstSize> >(17), "Sized BST matches std::set");
+    Assert(MatchesSet<Bst<int, BstAvl, BstArena, BstSize> >(17), "Sized AVL tree matches std::set");
+}
+
+// True if Select and Rank agree with the sorted values after random updates
+template <class Tree>
+bool OrderStatisticsMatch(unsigned int seed)
+{
+    Tree tree;
+    set<int> reference;
+    srand(seed);
+    for (int step = 0; step < 5000; step++)
+    {
+        int value = rand() % 1000;
+        if (rand() % 3 == 0)
+        {
+            tree.DeleteNode(value);
+            reference.erase(value);
+        }
+        else
+        {
+            tree.Insert(value);
+            reference.insert(value);
+        }
+    }
+
+    vector<int> sorted(reference.begin(), reference.end());
+    for (int k = 0; k < static_cast<int>(sorted.size()); k++)
+    {
+        if (tree.Select(k) == nullptr || *tree.Select(k) != sorted[k] || tree.Rank(sorted[k]) != k)
+        {
+            return false;
+        }
+    }
+    for (int value = -1; value <= 1000; value++)
+    {
+        int expected = static_cast<int>(lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+        if (tree.Rank(value) != expected)
+        {
+            return false;
+        }
+    }
+    return tree.Select(-1) == nullptr && tree.Select(static_cast<int>(sorted.size())) == nullptr;
+}
+
+// Verifies Select and Rank under inserts, deletes, rotations, copies and bulk builds
+void TestSelectRank()
+{
+    cout << "\n=== TestSelectRank ===\n";
+    Assert(OrderStatisticsMatch<Bst<int, BstUnbalanced, BstHeap, BstSize> >(5), "Plain sized BST");
+    Assert(OrderStatisticsMatch<Bst<int, BstAvl, BstArena, BstSize> >(5), "AVL sized tree");
+
+    Bst<int, BstAvl, BstArena, BstSize> tree;
+    vector<int> values;
+    for (int i = 0; i < 100; i++)
+    {
+        values.push_back(i * 10);
+    }
+    tree.BuildFromSorted(values.begin(), values.end());
+    Bst<int, BstAvl, BstArena, BstSize> copy(tree);
+    Assert(tree.GetSize() == 100 && *tree.Select(50) == 500 && tree.Rank(505) == 51, "Sizes set by BuildFromSorted");
+    Assert(*copy.Select(99) == 990 && copy.Rank(0) == 0, "Sizes kept by the copy constructor");
+
+    Bst<int, BstAvl, BstHeap, BstSize> empty;
+    Assert(empty.GetSize() == 0 && empty.Select(0) == nullptr && empty.Rank(7) == 0, "Empty tree");
+}
+
+// One aggregated field: the int itself
+struct IntField
+{
+    static const int count = 1;
+
+    static double Get(const int& value, int)
+    {
+        return value;
+    }
+};
+
+typedef Bst<int, BstAvl, BstArena, BstAggregate<IntField> > SumTree;
+
+// True if Summarize(lo, hi) matches a scan of the values, for random ranges
+bool SummariesMatch(const SumTree& tree, unsigned int seed)
+{
+    srand(seed);
+    for (int query = 0; query < 500; query++)
+    {
+        int lo = rand() % 1200 - 100;
+        int hi = rand() % 1200 - 100;
+        int count = 0;
+        double sum = 0.0, sumSq = 0.0;
+        tree.InOrder([&](const int& x)
+        {
+            if (x >= lo && x <= hi)
+            {
+                count++;
+                sum += x;
+                sumSq += static_cast<double>(x) * x;
+            }
+        });
+
+        BstAggregate<IntField>::Summary summary = tree.Summarize(lo, hi);
+        if (summary.GetCount() != count || summary.GetSum(0) != sum || summary.sumSq[0] != sumSq)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Verifies range aggregates through inserts, deletes, rotations and bulk builds
+void TestSummarize()
+{
+    cout << "\n=== TestSummarize ===\n";
+    SumTree tree;
+    srand(21);
+    for (int step = 0; step < 3000; step++)
+    {
+        int value = rand() % 1000;
+        if (rand() % 3 == 0)
+        {
+            tree.DeleteNode(value);
+        }
+        else
+        {
+            tree.Insert(value);
+        }
+    }
+    Assert(SummariesMatch(tree, 1), "Random ranges match a scan after inserts and deletes");
+
+    vector<int> values = {2, 4, 4, 4, 5, 5, 7, 9};
+    SumTree built;
+    built.BuildFromSorted(values.begin(), values.end());
+    BstAggregate<IntField>::Summary all = built.Summarize();
+    Assert(all.GetCount() == 5 && all.GetSum(0) == 27.0, "Whole-tree summary after BuildFromSorted");
+    Assert(fabs(all.GetMean(0) - 5.4) < 1e-9 && fabs(all.GetSd(0) - sqrt(7.3)) < 1e-9, "Mean and sample SD");
+
+    BstAggregate<IntField>::Summary none = built.Summarize(10, 20);
+    Assert(none.GetCount() == 0 && none.GetMean(0) == 0.0 && none.GetSd(0) == 0.0, "Empty range");
+    Assert(built.Summarize(9, 2).GetCount() == 0, "Empty when lo > hi");
+    Assert(*built.Select(2) == 5 && built.Rank(7) == 3, "Select and Rank work on aggregated trees");
+}
+
+// Verifies that a long chain is traversed, copied and freed without recursion
+void TestDeepChain()
+{
+    cout << "\n=== TestDeepChain ===\n";
+    const int count = 20000;
+    Bst<int> chain;
+    for (int i = 0; i < count; i++)
+    {
+        chain.Insert(i);
+    }
+
+    ResetVisited();
+    chain.PostOrder(Collect);
+    Assert(chain.GetHeight() == count && visited.size() == static_cast<size_t>(count) && visited.front() == count - 1,
+           "Post-order walks the whole chain");
+
+    Bst<int> copy(chain);
+    Assert(copy.GetHeight() == count && copy.Search(count - 1), "Chain copied");
+
+    chain.DeleteTree();
+    Assert(chain.GetHeight() == 0 && copy.Search(0), "Chain freed, copy intact");
+}
+
+// Verifies arena trees with values that own memory, and bulk release
+void TestArena()
+{
+    cout << "\n=== TestArena ===\n";
+    Bst<string, BstAvl, BstArena> tree;
+    for (int i = 0; i < 5000; i++)
+    {
+        tree.Insert("value number " + to_string(i));
+    }
+    for (int i = 0; i < 5000; i += 2)
+    {
+        tree.DeleteNode("value number " + to_string(i));
+    }
+    tree.Insert("reuses a freed slot");
+
+    Assert(tree.Search("value number 4999") && !tree.Search("value number 4998"), "Arena tree search");
+    Assert(tree.Search("reuses a freed slot"), "Insert after deletes");
+
+    Bst<string, BstAvl, BstArena> copy;
+    copy = tree;
+    tree.DeleteTree();
+    Assert(tree.GetHeight() == 0 && copy.Search("value number 1"), "Copy survives DeleteTree");
+
+    tree.Insert("fresh");
+    Assert(tree.Search("fresh") && !tree.Search("value number 1"), "Tree reusable after DeleteTree");
+}
+
+// Verifies that Compact rebalances without changing the contents
+void TestCompact()
+{
+    cout << "\n=== TestCompact ===\n";
+    Bst<int, BstUnbalanced, BstArena> chain;
+    for (int i = 0; i < 1023; i++)
+    {
+        chain.Insert(i);
+    }
+    chain.Compact();
+
+    ResetVisited();
+    chain.InOrder(Collect);
+    Assert(chain.GetHeight() == 10, "Chain of 1023 rebuilt with height 10");
+    Assert(visited.size() == 1023 && visited.front() == 0 && visited.back() == 1022, "Values kept in order");
+
+    Bst<int, BstAvl> avl;
+    for (int i = 0; i < 100; i++)
+    {
+        avl.Insert((i * 37) % 100);
+    }
+    avl.Compact();
+    for (int i = 100; i < 1000; i++)
+    {
+        avl.Insert(i);
+    }
+    Assert(avl.GetHeight() <= 11 && avl.Search(0) && avl.Search(999), "AVL stays balanced after Compact");
+
+    Bst<int> empty;
+    empty.Compact();
+    Assert(empty.GetHeight() == 0, "Compact on an empty tree");
+}
+
+// Verifies that VisitRange visits exactly the values in [lo, hi], in order
+void TestVisitRange()
+{
+    cout << "\n=== TestVisitRange ===\n";
+    Bst<int, BstAvl> tree;
+    for (int i = 0; i < 100; i += 2)
+    {
+        tree.Insert(i);
+    }
+
+    ResetVisited();
+    tree.VisitRange(9, 20, Collect);
+    vector<int> expected = {10, 12, 14, 16, 18, 20};
+    Assert(visited == expected, string("VisitRange(9, 20) = ") + VecToStr(visited));
+
+    ResetVisited();
+    tree.VisitRange(-10, -1, Collect);
+    tree.VisitRange(99, 500, Collect);
+    Assert(visited.empty(), "Ranges below and above the tree visit nothing");
+
+    ResetVisited();
+    tree.VisitRange(20, 10, Collect);
+    Assert(visited.empty(), "Empty range when lo > hi");
+
+    ResetVisited();
+    tree.VisitRange(-5, 1000, Collect);
+    Assert(visited.size() == 50, "Range covering the tree visits every value");
+
+    Bst<int> empty;
+    ResetVisited();
+    empty.VisitRange(0, 10, Collect);
+    Assert(visited.empty(), "Empty tree visits nothing");
+}
+
+// Verifies that traversals take lambdas and stop when one returns false
+void TestCallableTraversal()
+{
+    cout << "\n=== TestCallableTraversal ===\n";
+    Bst<int, BstAvl> tree;
+    for (int i = 1; i <= 10; i++)
+    {
+        tree.Insert(i);
+    }
+
+    int sum = 0;
+    bool finished = tree.InOrder([&sum](const int& x) { sum += x; });
+    Assert(finished && sum == 55, "Capturing lambda sums every value");
+
+    vector<int> seen;
+    finished = tree.InOrder([&seen](const int& x) { seen.push_back(x); return x < 4; });
+    vector<int> expected = {1, 2, 3, 4};
+    Assert(!finished && seen == expected, string("InOrder stops early = ") + VecToStr(seen));
+
+    int count = 0;
+    finished = tree.PreOrder([&count](const int&) { return ++count < 3; });
+    Assert(!finished && count == 3, "PreOrder stops early");
+
+    count = 0;
+    finished = tree.PostOrder([&count](const int&) { return ++count < 5; });
+    Assert(!finished && count == 5, "PostOrder stops early");
+
+    seen.clear();
+    finished = tree.VisitRange(3, 8, [&seen](const int& x) { seen.push_back(x); return x != 5; });
+    expected = {3, 4, 5};
+    Assert(!finished && seen == expected, string("VisitRange stops early = ") + VecToStr(seen));
+}
+
+// Verifies in-order iteration forwards and backwards, against InOrder
+void TestIterator()
+{
+    cout << "\n=== TestIterator ===\n";
+    Bst<int> tree;
+    srand(7);
+    for (int i = 0; i < 500; i++)
+    {
+        tree.Insert(rand() % 1000);
+    }
+
+    ResetVisited();
+    tree.InOrder(Collect);
+
+    vector<int> forward;
+    for (const int& x : tree)
+    {
+        forward.push_back(x);
+    }
+    Assert(forward == visited, "Forward iteration matches InOrder");
+
+    vector<int> backward;
+    Bst<int>::Iterator it = tree.end();
+    while (it != tree.begin())
+    {
+        --it;
+        backward.push_back(*it);
+    }
+    Assert(vector<int>(backward.rbegin(), backward.rend()) == visited, "Backward iteration matches InOrder");
+
+    it = tree.begin();
+    Bst<int>::Iterator old = it++;
+    Assert(*old == visited[0] && *it == visited[1], "Postfix increment returns the old position");
+    it--;
+    Assert(it == old, "Decrement returns to the same node");
+
+    Bst<int> empty;
+    Assert(empty.begin() == empty.end(), "Empty tree has begin() == end()");
+}
+
+// Verifies linear bulk builds, merging into a filled tree and the unsorted fallback
+void TestBuildFromSorted()
+{
+    cout << "\n=== TestBuildFromSorted ===\n";
+    vector<int> sorted;
+    for (int i = 0; i < 1023; i++)
+    {
+        sorted.push_back(i * 2);
+    }
+
+    Bst<int, BstAvl, BstArena> tree;
+    int duplicates = tree.BuildFromSorted(sorted.begin(), sorted.end());
+    Assert(duplicates == 0 && tree.GetHeight() == 10, "1023 sorted values built with height 10");
+    Assert(equal(tree.begin(), tree.end(), sorted.begin()), "Values kept in order");
+
+    bool contiguous = true;
+    const int* previous = nullptr;
+    for (const int& x : tree)
+    {
+        contiguous = contiguous && (previous == nullptr || previous < &x);
+        previous = &x;
+    }
+    Assert(contiguous, "Arena nodes laid out in sorted order");
+
+    vector<int> more = {-1, 0, 1, 1, 3, 2044, 5000};
+    duplicates = tree.BuildFromSorted(more.begin(), more.end());
+    Assert(duplicates == 3, "Duplicates in the tree and within the run counted");
+    Assert(tree.Search(-1) && tree.Search(1) && tree.Search(3) && tree.Search(5000), "Run merged into the tree");
+    Assert(tree.GetHeight() == 11 && is_sorted(tree.begin(), tree.end()), "Merged tree balanced and ordered");
+
+    Bst<int> chain;
+    vector<int> unsorted = {5, 3, 8, 3, 1};
+    duplicates = chain.BuildFromSorted(unsorted.begin(), unsorted.end());
+    ResetVisited();
+    chain.PreOrder(Collect);
+    vector<int> expected = {5, 3, 1, 8};
+    Assert(duplicates == 1 && visited == expected, "Unsorted run inserted one by one");
+
+    Bst<int> empty;
+    Assert(empty.BuildFromSorted(sorted.begin(), sorted.begin()) == 0 && empty.begin() == empty.end(),
+           "Empty run leaves an empty tree");
+}
+
 int main()
 {
     TestInsertAndSearch();
@@ -306,7 +840,20 @@ int main()
     TestDeleteTree();
     TestCopyConstructor();
     TestAssignmentOperator();
+    TestMove();
     TestInvariantChecker();
+    TestAvlSortedInsert();
+    TestAvlDelete();
+    TestRandomOperations();
+    TestDeepChain();
+    TestArena();
+    TestCompact();
+    TestVisitRange();
+    TestCallableTraversal();
+    TestIterator();
+    TestBuildFromSorted();
+    TestSelectRank();
+    TestSummarize();
 
     cout << "\n=== ALL TESTS COMPLETE ===\n";
     return 0;
@@ -0,0 +1,1163 @@
+#include "CsvParser.h"
+#include "MappedFile.h"
+#include "CsvScanner.h"
+#include "Parallel.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
+#include <cstring>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+
+using std::ifstream;
+using std::stringstream;
+using std::stof;
+using std::invalid_argument;
+using std::out_of_range;
+
+// Smallest byte range worth handing to its own parsing thread
+const long long MIN_CHUNK_BYTES = 1 << 20;
+
+// Chunks per thread, so uneven chunks still balance across workers
+const int CHUNKS_PER_THREAD = 4;
+
+// Compare the slice against a null-terminated string
+bool CsvField::Equals(const char* text) const
+{
+    int textLength = static_cast<int>(strlen(text));
+    return textLength == length && memcmp(data, text, length) == 0;
+}
+
+// Copy the slice into a string
+string CsvField::ToString() const
+{
+    return string(data, length);
+}
+
+// Names used when reporting reject counts
+const char* RejectReasonName(RejectReason reason)
+{
+    switch(reason)
+    {
+    case REJECT_SHORT_ROW:
+        return "short row";
+    case REJECT_BAD_TIMESTAMP:
+        return "bad timestamp";
+    case REJECT_SENTINEL:
+        return "missing value";
+    case REJECT_BAD_NUMBER:
+        return "invalid number";
+    case REJECT_OUT_OF_RANGE:
+        return "out-of-range value";
+    case REJECT_UNFINISHED:
+        return "unfinished last row";
+    case REJECT_DUPLICATE:
+        return "duplicate timestamp";
+    default:
+        return "unknown";
+    }
+}
+
+// Start with no rows and no rejects
+LoadStats::LoadStats()
+    : rows(0)
+{
+    for(int r = 0; r < REJECT_REASON_COUNT; r++)
+    {
+        rejects[r] = 0;
+    }
+}
+
+// Count a reject, keeping its line number while the sample has room
+void LoadStats::Reject(RejectReason reason, long long line)
+{
+    rejects[reason]++;
+    if(line > 0 && lines[reason].GetSize() < LOAD_STATS_SAMPLES)
+    {
+        lines[reason].PushBack(line);
+    }
+}
+
+// Count rejects without sampling their lines
+void LoadStats::AddRejects(RejectReason reason, long long count)
+{
+    rejects[reason] += count;
+}
+
+// Uncount a row and drop its line number from the sample
+void LoadStats::Withdraw(RejectReason reason, long long line)
+{
+    rows--;
+    rejects[reason]--;
+    for(int i = 0; i < lines[reason].GetSize(); i++)
+    {
+        if(lines[reason][i] == line)
+        {
+            lines[reason].Delete(i);
+            break;
+        }
+    }
+}
+
+// Add the counts and samples of another range of rows
+void LoadStats::Add(const LoadStats& other, long long lineOffset)
+{
+    rows += other.rows;
+    for(int r = 0; r < REJECT_REASON_COUNT; r++)
+    {
+        rejects[r] += other.rejects[r];
+        for(int i = 0; i < other.lines[r].GetSize() && lines[r].GetSize() < LOAD_STATS_SAMPLES; i++)
+        {
+            lines[r].PushBack(other.lines[r][i] + lineOffset);
+        }
+    }
+}
+
+// Sum of rejects over all reasons
+long long LoadStats::TotalRejects() const
+{
+    long long total = 0;
+    for(int r = 0; r < REJECT_REASON_COUNT; r++)
+    {
+        total += rejects[r];
+    }
+    return total;
+}
+
+// Check if a string represents a valid numeric value
+bool IsValidNumber(const string& s)
+{
+    return IsValidNumber(s.data(), static_cast<int>(s.size()));
+}
+
+// Check if a character range represents a valid numeric value
+bool IsValidNumber(const char* s, int length)
+{
+    if(length <= 0)
+    {
+        return false;
+    }
+
+    // Compare lowercase against "na", "n/a", "---", "-9999" (all at most 5 chars)
+    if(length <= 5)
+    {
+        char lower[6];
+        for(int i = 0; i < length; ++i)
+        {
+            char c = s[i];
+            if(c >= 'A' && c <= 'Z')
+            {
+                c = c - 'A' + 'a';
+            }
+            lower[i] = c;
+        }
+        lower[length] = '\0';
+
+        if(strcmp(lower, "na") == 0 || strcmp(lower, "n/a") == 0 ||
+                strcmp(lower, "---") == 0 || strcmp(lower, "-9999") == 0)
+        {
+            return false;
+        }
+    }
+
+    bool hasDigit = false, hasDot = false, hasE = false;
+
+    for(int i = 0; i < length; ++i)
+    {
+        char c = s[i];
+        if(c >= '0' && c <= '9')
+        {
+            hasDigit = true;
+        }
+        else if(c == '.')
+        {
+            if(hasDot || hasE)
+            {
+                return false;
+            }
+            hasDot = true;
+        }
+        else if(c == 'e' || c == 'E')
+        {
+            if(hasE || !hasDigit || i + 1 == length)
+            {
+                return false;
+            }
+            hasE = true;
+            hasDigit = false;
+        }
+        else if(c == '+' || c == '-')
+        {
+            if (i > 0 && s[i - 1] != 'e' && s[i - 1] != 'E')
+            {
+                return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return hasDigit;
+}
+
+// Case-insensitive comparison of a field with a lowercase sentinel
+static bool MatchesSentinel(const char* s, int length, const char* sentinel, int sentinelLength)
+{
+    if(length != sentinelLength)
+    {
+        return false;
+    }
+    for(int i = 0; i < length; i++)
+    {
+        char c = s[i];
+        if(c >= 'A' && c <= 'Z')
+        {
+            c = c - 'A' + 'a';
+        }
+        if(c != sentinel[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Exact powers of ten representable as float
+static const float FLOAT_POW10[] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+// Exact powers of ten representable as double
+static const double DOUBLE_POW10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Largest mantissa kept exactly; further digits only shift the exponent
+const unsigned long long MAX_MANTISSA = 100000000000000000ULL;
+
+// Validate and convert a numeric field in one pass
+NumberStatus ParseNumber(const char* s, int length, float& value)
+{
+    if(length <= 0 ||
+            MatchesSentinel(s, length, "na", 2) || MatchesSentinel(s, length, "n/a", 3) ||
+            MatchesSentinel(s, length, "---", 3) || MatchesSentinel(s, length, "-9999", 5))
+    {
+        return NUMBER_SENTINEL;
+    }
+
+    int i = 0;
+    bool negative = false;
+    if(s[0] == '+' || s[0] == '-')
+    {
+        negative = (s[0] == '-');
+        i++;
+    }
+
+    // Mantissa digits, with an optional '.'
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    bool hasDigit = false, hasDot = false, truncated = false;
+    for(; i < length; i++)
+    {
+        char c = s[i];
+        if(c >= '0' && c <= '9')
+        {
+            hasDigit = true;
+            if(mantissa < MAX_MANTISSA)
+            {
+                mantissa = mantissa * 10 + (c - '0');
+                exponent -= hasDot ? 1 : 0;
+            }
+            else
+            {
+                truncated = truncated || (c != '0');
+                exponent += hasDot ? 0 : 1;
+            }
+        }
+        else if(c == '.' && !hasDot)
+        {
+            hasDot = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if(!hasDigit)
+    {
+        return NUMBER_INVALID;
+    }
+
+    // Optional exponent: 'e', optional sign, at least one digit
+    if(i < length)
+    {
+        if(s[i] != 'e' && s[i] != 'E')
+        {
+            return NUMBER_INVALID;
+        }
+        i++;
+
+        bool negativeExp = false;
+        if(i < length && (s[i] == '+' || s[i] == '-'))
+        {
+            negativeExp = (s[i] == '-');
+            i++;
+        }
+        if(i == length)
+        {
+            return NUMBER_INVALID;
+        }
+
+        int expValue = 0;
+        for(; i < length; i++)
+        {
+            char c = s[i];
+            if(c < '0' || c > '9')
+            {
+                return NUMBER_INVALID;
+            }
+            if(expValue < 100000)
+            {
+                expValue = expValue * 10 + (c - '0');
+            }
+        }
+        exponent += negativeExp ? -expValue : expValue;
+    }
+
+    // Fast path: both operands exact in float, so one rounding, as strtof does
+    double result;
+    if(mantissa <= (1ULL << 24) && exponent >= -10 && exponent <= 10 && !truncated)
+    {
+        float f = static_cast<float>(mantissa);
+        f = (exponent < 0) ? f / FLOAT_POW10[-exponent] : f * FLOAT_POW10[exponent];
+        value = negative ? -f : f;
+        return NUMBER_OK;
+    }
+    else if(mantissa == 0)
+    {
+        result = 0.0;
+    }
+    else if(mantissa < (1ULL << 53) && exponent >= -22 && exponent <= 22)
+    {
+        result = static_cast<double>(mantissa);
+        result = (exponent < 0) ? result / DOUBLE_POW10[-exponent] : result * DOUBLE_POW10[exponent];
+    }
+    else if(exponent > 60)
+    {
+        return NUMBER_OUT_OF_RANGE;
+    }
+    else if(exponent < -80)
+    {
+        return NUMBER_OUT_OF_RANGE;
+    }
+    else
+    {
+        result = static_cast<double>(mantissa) * pow(10.0, exponent);
+    }
+
+    // Same range rules as stof: overflow or a non-zero result below FLT_MIN
+    if(result > FLT_MAX || (result != 0.0 && result < FLT_MIN))
+    {
+        return NUMBER_OUT_OF_RANGE;
+    }
+
+    value = static_cast<float>(negative ? -result : result);
+    return NUMBER_OK;
+}
+
+// Whitespace as skipped by sscanf
+static bool IsScanSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+// Read an integer like sscanf's %d: skip whitespace, optional sign, at least one digit
+static bool ScanInt(const char* s, int length, int& i, int& value)
+{
+    while(i < length && IsScanSpace(s[i]))
+    {
+        i++;
+    }
+
+    bool negative = false;
+    if(i < length && (s[i] == '+' || s[i] == '-'))
+    {
+        negative = (s[i] == '-');
+        i++;
+    }
+    if(i >= length || s[i] < '0' || s[i] > '9')
+    {
+        return false;
+    }
+
+    int v = 0;
+    for(; i < length && s[i] >= '0' && s[i] <= '9'; i++)
+    {
+        if(v < 100000000)
+        {
+            v = v * 10 + (s[i] - '0');
+        }
+    }
+    value = negative ? -v : v;
+    return true;
+}
+
+// Match one literal character of the format
+static bool ScanChar(const char* s, int length, int& i, char c)
+{
+    if(i >= length || s[i] != c)
+    {
+        return false;
+    }
+    i++;
+    return true;
+}
+
+// Decode "%d/%d/%d %d:%d" into a packed key, reusing the previous row's date
+WastStatus ParseWast(const char* s, int length, WastCache& cache, unsigned long long& key)
+{
+    int i = 0;
+
+    // Same date text as the previous row, ending before a non-digit: same date
+    int cached = cache.prefixLength;
+    if(cached > 0 && length > cached && memcmp(s, cache.prefix, cached) == 0 &&
+            (s[cached] < '0' || s[cached] > '9'))
+    {
+        i = cached;
+    }
+    else
+    {
+        int day, month, year;
+        if(!ScanInt(s, length, i, day) || !ScanChar(s, length, i, '/') ||
+                !ScanInt(s, length, i, month) || !ScanChar(s, length, i, '/') ||
+                !ScanInt(s, length, i, year))
+        {
+            return WAST_BAD_FORMAT;
+        }
+
+        cache.prefixLength = (i <= WAST_PREFIX_MAX) ? i : 0;
+        memcpy(cache.prefix, s, cache.prefixLength);
+        cache.day = day;
+        cache.month = month;
+        cache.year = year;
+        cache.dateValid = (day >= 1 && day <= 31 && month >= 1 && month <= 12 && year > 0);
+    }
+
+    // The space in the format matches any whitespace, which ScanInt skips
+    int hour, minute;
+    if(!ScanInt(s, length, i, hour) || !ScanChar(s, length, i, ':') ||
+            !ScanInt(s, length, i, minute))
+    {
+        return WAST_BAD_FORMAT;
+    }
+
+    if(!cache.dateValid)
+    {
+        return WAST_BAD_DATE;
+    }
+
+    // Time::SetTime stores out-of-range values as 0
+    if(hour < 0 || hour >= 24)
+    {
+        hour = 0;
+    }
+    if(minute < 0 || minute >= 60)
+    {
+        minute = 0;
+    }
+
+    key = PackDateTime(cache.year, cache.month, cache.day, hour, minute);
+    return WAST_OK;
+}
+
+// Split a line on ',' into slices, matching getline(ss, token, ',')
+void SplitCsvLine(const char* begin, const char* end, Vector<CsvField>& fields)
+{
+    fields.Clear();
+
+    const char* start = begin;
+    for(const char* p = begin; p < end; ++p)
+    {
+        if(*p == ',')
+        {
+            fields.PushBack(CsvField(start, static_cast<int>(p - start)));
+            start = p + 1;
+        }
+    }
+
+    // getline does not report an empty token after a trailing comma
+    if(start < end)
+    {
+        fields.PushBack(CsvField(start, static_cast<int>(end - start)));
+    }
+}
+
+// Find the indices of WAST, S, T and SR in a header row
+void MapCsvColumns(const Vector<CsvField>& header, CsvColumns& columns)
+{
+    columns = CsvColumns();
+    columns.count = header.GetSize();
+
+    for(int i = 0; i < header.GetSize(); i++)
+    {
+        if(header[i].Equals("WAST"))
+        {
+            columns.idxWAST = i;
+        }
+        else if(header[i].Equals("S"))
+        {
+            columns.idxWind = i;
+        }
+        else if(header[i].Equals("T"))
+        {
+            columns.idxTemp = i;
+        }
+        else if(header[i].Equals("SR"))
+        {
+            columns.idxSolar = i;
+        }
+    }
+}
+
+// Append a record to partitions[year][month]
+static void AddToPartition(RecPartitions& out, int year, int month, const RecNode& recNode)
+{
+    out.TryEmplace(year).TryEmplace(month).PushBack(recNode);
+}
+
+// Return the end of the line starting at p (the '\n' or the buffer end)
+static const char* FindLineEnd(const char* p, const char* end)
+{
+    const void* nl = memchr(p, '\n', end - p);
+    return (nl != nullptr) ? static_cast<const char*>(nl) : end;
+}
+
+// Return the position just past the last '\n' in [begin, end), or begin if there is none
+static const char* LastRowEnd(const char* begin, const char* end)
+{
+    const char* p = end;
+    while(p > begin && p[-1] != '\n')
+    {
+        p--;
+    }
+    return p;
+}
+
+// Count a final row without a newline, which a followed file leaves for a later read
+static void HoldBackRow(const char* rowsEnd, const char* end, LoadStats& stats)
+{
+    if(rowsEnd < end)
+    {
+        stats.rows++;
+        stats.Reject(REJECT_UNFINISHED, stats.rows);
+    }
+}
+
+// Slice field i out of a row, given the offsets of its commas
+static CsvField RowField(const char* line, int lineLength, const int* commas, int commaCount, int index)
+{
+    int begin = (index == 0) ? 0 : commas[index - 1] + 1;
+    int end = (index < commaCount) ? commas[index] : lineLength;
+    return CsvField(line + begin, end - begin);
+}
+
+// One data row that passed validation
+struct CsvRecord
+{
+    unsigned long long key;  // packed WAST
+    int year;
+    int month;
+    float wind;              // as stored in the file
+    float temp;
+    float solar;
+    float extra;             // extra sensor column, NaN if missing or invalid
+    const char* rowBegin;    // first character of the row
+    const char* rowNext;     // first character of the next row
+};
+
+// Validate every row in [begin, end), count the rejected ones in stats
+// and pass the accepted ones to onRecord
+template<class Func>
+static int ForEachCsvRecord(const char* begin, const char* end, const CsvColumns& columns,
+                            LoadStats* stats, Func onRecord)
+{
+    LoadStats ignored;
+    if(stats == nullptr)
+    {
+        stats = &ignored;
+    }
+
+    // Projection: only the commas up to the end of the rightmost column
+    // read are located; the rest of the row is skipped with memchr
+    int lastNeeded = columns.LastNeeded();
+    int wantedCommas = columns.LastScanned() + 1;
+    Vector<int> commaBuffer(wantedCommas);
+    int* commas = &commaBuffer[0];
+    WastCache wastCache;
+    int records = 0;
+    long long line = 0;
+
+    const char* p = begin;
+    while(p < end)
+    {
+        int commaCount;
+        const char* lineBegin = p;
+        line++;
+        const char* stop = ScanCsvFields(p, end, commas, wantedCommas, commaCount);
+        const char* lineEnd = (commaCount == wantedCommas) ? FindLineEnd(stop, end) : stop;
+        p = (lineEnd < end) ? lineEnd + 1 : end;
+
+        if(lineEnd > lineBegin && lineEnd[-1] == '\r')
+        {
+            lineEnd--;
+        }
+
+        // Skip rows too short to reach the rightmost required field. When
+        // that field is the row's last it runs to the line end.
+        int lineLength = static_cast<int>(lineEnd - lineBegin);
+        if(commaCount < lastNeeded || lineLength == 0)
+        {
+            stats->Reject(REJECT_SHORT_ROW, line);
+            continue;
+        }
+
+        CsvField wastField = RowField(lineBegin, lineLength, commas, commaCount, columns.idxWAST);
+        CsvField windField = RowField(lineBegin, lineLength, commas, commaCount, columns.idxWind);
+        CsvField tempField = RowField(lineBegin, lineLength, commas, commaCount, columns.idxTemp);
+        CsvField solarField = RowField(lineBegin, lineLength, commas, commaCount, columns.idxSolar);
+
+        // Decode WAST straight into a packed key
+        CsvRecord record;
+        WastStatus wastStatus = ParseWast(wastField.data, wastField.length, wastCache, record.key);
+        if(wastStatus == WAST_BAD_FORMAT)
+        {
+            stats->Reject(REJECT_BAD_TIMESTAMP, line);
+            continue;
+        }
+
+        // Validate and convert the numeric fields in one pass each
+        NumberStatus windStatus = ParseNumber(windField.data, windField.length, record.wind);
+        NumberStatus tempStatus = ParseNumber(tempField.data, tempField.length, record.temp);
+        NumberStatus solarStatus = ParseNumber(solarField.data, solarField.length, record.solar);
+        if(windStatus == NUMBER_SENTINEL || tempStatus == NUMBER_SENTINEL || solarStatus == NUMBER_SENTINEL)
+        {
+            stats->Reject(REJECT_SENTINEL, line);
+            continue;
+        }
+        if(windStatus == NUMBER_INVALID || tempStatus == NUMBER_INVALID || solarStatus == NUMBER_INVALID)
+        {
+            stats->Reject(REJECT_BAD_NUMBER, line);
+            continue;
+        }
+        if(windStatus != NUMBER_OK || tempStatus != NUMBER_OK || solarStatus != NUMBER_OK)
+        {
+            stats->Reject(REJECT_OUT_OF_RANGE, line);
+            continue;
+        }
+
+        if(wastStatus == WAST_BAD_DATE)
+        {
+            stats->Reject(REJECT_BAD_TIMESTAMP, line);
+            continue;
+        }
+
+        // The extra column never rejects a row; a missing or bad value is stored as NaN
+        record.extra = NAN;
+        if(columns.idxExtra != -1 && columns.idxExtra <= commaCount)
+        {
+            CsvField extraField = RowField(lineBegin, lineLength, commas, commaCount, columns.idxExtra);
+            float extra;
+            if(ParseNumber(extraField.data, extraField.length, extra) == NUMBER_OK)
+            {
+                record.extra = extra;
+            }
+        }
+
+        DateTimeKey key(record.key);
+        record.year = key.GetYear();
+        record.month = key.GetMonth();
+        record.rowBegin = lineBegin;
+        record.rowNext = p;
+        onRecord(record);
+        records++;
+    }
+
+    stats->rows += line;
+    return records;
+}
+
+// Extend the last span if it covers the same month, otherwise start a new one
+static void AddSpan(Vector<CsvSpan>& spans, int year, int month, long long begin, long long end)
+{
+    int last = spans.GetSize() - 1;
+    if(last >= 0 && spans[last].year == year && spans[last].month == month)
+    {
+        spans[last].end = end;
+    }
+    else
+    {
+        spans.PushBack(CsvSpan(year, month, begin, end));
+    }
+}
+
+// Parse mapped rows into partitions
+int ParseCsvRows(const char* begin, const char* end, const CsvColumns& columns, RecPartitions& out,
+                 Vector<CsvSpan>* spans, LoadStats* stats)
+{
+    return ForEachCsvRecord(begin, end, columns, stats, [&](const CsvRecord& record)
+    {
+        RecNode recNode(record.key, record.wind * 3.6f, record.solar * 0.0001667f, record.temp); // km/h, kWh/m2
+        AddToPartition(out, record.year, record.month, recNode);
+
+        if(spans != nullptr)
+        {
+            AddSpan(*spans, record.year, record.month, record.rowBegin - begin, record.rowNext - begin);
+        }
+    });
+}
+
+// Collect the extra column of one month's rows
+int ParseSensorRows(const char* begin, const char* end, const CsvColumns& columns,
+                    int year, int month, Vector<SensorSample>& out)
+{
+    int samples = 0;
+    ForEachCsvRecord(begin, end, columns, nullptr, [&](const CsvRecord& record)
+    {
+        if(record.year == year && record.month == month)
+        {
+            out.PushBack(SensorSample(record.key, record.extra));
+            samples++;
+        }
+    });
+    return samples;
+}
+
+// Append every partition of src to the matching partition of dst,
+// moving the records (or the whole month when dst has none yet)
+static void AppendPartitions(RecPartitions& dst, RecPartitions& src)
+{
+    Vector<int> yearKeys;
+    src.GetKeys(yearKeys);
+    for(int y = 0; y < yearKeys.GetSize(); y++)
+    {
+        Map<int, Vector<RecNode>>& months = src[yearKeys[y]];
+        Vector<int> monthKeys;
+        months.GetKeys(monthKeys);
+
+        for(int m = 0; m < monthKeys.GetSize(); m++)
+        {
+            Vector<RecNode>& from = months[monthKeys[m]];
+            Vector<RecNode>& to = dst.TryEmplace(yearKeys[y]).TryEmplace(monthKeys[m]);
+            if(to.IsEmpty())
+            {
+                to = std::move(from);
+                continue;
+            }
+            for(int i = 0; i < from.GetSize(); i++)
+            {
+                to.PushBack(std::move(from[i]));
+            }
+        }
+    }
+}
+
+// Parse newline-aligned chunks of the buffer concurrently
+int ParseCsvRowsChunked(const char* begin, const char* end, const CsvColumns& columns,
+                        RecPartitions& out, int threads, Vector<CsvSpan>* spans, LoadStats* stats)
+{
+    threads = ResolveThreadCount(threads);
+    long long bytes = end - begin;
+    long long chunkCount = bytes / MIN_CHUNK_BYTES;
+    if(chunkCount > static_cast<long long>(threads) * CHUNKS_PER_THREAD)
+    {
+        chunkCount = static_cast<long long>(threads) * CHUNKS_PER_THREAD;
+    }
+    if(threads <= 1 || chunkCount <= 1)
+    {
+        return ParseCsvRows(begin, end, columns, out, spans, stats);
+    }
+
+    // Cut at roughly equal offsets, then move each cut past the next newline
+    Vector<const char*> bounds;
+    bounds.PushBack(begin);
+    for(long long c = 1; c < chunkCount; c++)
+    {
+        const char* cut = begin + bytes * c / chunkCount;
+        if(cut < bounds[bounds.GetSize() - 1])
+        {
+            cut = bounds[bounds.GetSize() - 1];
+        }
+        cut = FindLineEnd(cut, end);
+        bounds.PushBack((cut < end) ? cut + 1 : end);
+    }
+    bounds.PushBack(end);
+
+    // Chunk 0 parses straight into out; the others into their own partitions
+    int chunks = bounds.GetSize() - 1;
+    Vector<RecPartitions> parts(chunks);
+    Vector<Vector<CsvSpan>> chunkSpans(chunks);
+    Vector<LoadStats> chunkStats(chunks);
+    Vector<int> counts(chunks);
+    ParallelFor(chunks, threads, [&](int c)
+    {
+        RecPartitions& target = (c == 0) ? out : parts[c];
+        counts[c] = ParseCsvRows(bounds[c], bounds[c + 1], columns, target,
+                                 (spans != nullptr) ? &chunkSpans[c] : nullptr, &chunkStats[c]);
+    });
+
+    int records = 0;
+    long long linesBefore = 0;
+    for(int c = 0; c < chunks; c++)
+    {
+        if(c > 0)
+        {
+            AppendPartitions(out, parts[c]);
+            parts[c].Clear();
+        }
+        records += counts[c];
+
+        // Chunk line numbers start at 1; shift them past the earlier chunks
+        if(stats != nullptr)
+        {
+            stats->Add(chunkStats[c], linesBefore);
+        }
+        linesBefore += chunkStats[c].rows;
+
+        // Chunk spans are relative to the chunk; rebase them and join
+        // a month that continues across the chunk boundary
+        if(spans != nullptr)
+        {
+            long long offset = bounds[c] - begin;
+            for(int i = 0; i < chunkSpans[c].GetSize(); i++)
+            {
+                const CsvSpan& span = chunkSpans[c][i];
+                AddSpan(*spans, span.year, span.month, span.begin + offset, span.end + offset);
+            }
+        }
+    }
+    return records;
+}
+
+// Load one CSV file through a memory mapping
+CsvReadStatus ReadCsvMapped(const string& path, RecPartitions& out, int& records, int threads,
+                            Vector<CsvSpan>* spans, LoadStats* stats, long long* readTo)
+{
+    MappedFile file;
+    if(!file.Open(path))
+    {
+        return CSV_OPEN_FAILED;
+    }
+
+    const char* begin = file.GetData();
+    const char* end = begin + file.GetSize();
+
+    // Read CSV header and map column indices
+    const char* headerEnd = FindLineEnd(begin, end);
+    const char* rowsBegin = (headerEnd < end) ? headerEnd + 1 : end;
+    if(headerEnd > begin && headerEnd[-1] == '\r')
+    {
+        headerEnd--;
+    }
+
+    Vector<CsvField> header;
+    SplitCsvLine(begin, headerEnd, header);
+
+    CsvColumns columns;
+    MapCsvColumns(header, columns);
+    if(!columns.HasRequired())
+    {
+        return CSV_MISSING_COLUMNS;
+    }
+
+    // A followed file stops after the last newline: a row still being
+    // written is read once, complete, by a later ReadCsvAppended()
+    const char* rowsEnd = (readTo != nullptr) ? LastRowEnd(rowsBegin, end) : end;
+
+    Vector<CsvSpan> rowSpans;
+    LoadStats rowStats;
+    records += ParseCsvRowsChunked(rowsBegin, rowsEnd, columns, out, threads,
+                                   (spans != nullptr) ? &rowSpans : nullptr, &rowStats);
+    HoldBackRow(rowsEnd, end, rowStats);
+
+    // Line 1 is the header
+    if(stats != nullptr)
+    {
+        stats->Add(rowStats, 1);
+    }
+    if(readTo != nullptr)
+    {
+        *readTo = rowsEnd - begin;
+    }
+
+    // Store the spans as file offsets
+    if(spans != nullptr)
+    {
+        long long offset = rowsBegin - begin;
+        for(int i = 0; i < rowSpans.GetSize(); i++)
+        {
+            const CsvSpan& span = rowSpans[i];
+            spans->PushBack(CsvSpan(span.year, span.month, span.begin + offset, span.end + offset));
+        }
+    }
+    return CSV_OK;
+}
+
+// Read the complete rows appended after offset
+CsvReadStatus ReadCsvAppended(const string& path, long long& offset, RecPartitions& out, int& records,
+                              Vector<CsvSpan>* spans, LoadStats* stats)
+{
+    MappedFile file;
+    if(!file.Open(path))
+    {
+        return CSV_OPEN_FAILED;
+    }
+    if(file.GetSize() < offset)
+    {
+        return CSV_TRUNCATED;
+    }
+    if(file.GetSize() == offset)
+    {
+        return CSV_OK;
+    }
+
+    const char* begin = file.GetData();
+    const char* end = begin + file.GetSize();
+
+    // The header may have changed column order since the last read
+    const char* headerEnd = FindLineEnd(begin, end);
+    const char* rowsBegin = (headerEnd < end) ? headerEnd + 1 : end;
+    if(headerEnd > begin && headerEnd[-1] == '\r')
+    {
+        headerEnd--;
+    }
+
+    Vector<CsvField> header;
+    SplitCsvLine(begin, headerEnd, header);
+
+    CsvColumns columns;
+    MapCsvColumns(header, columns);
+    if(!columns.HasRequired())
+    {
+        return CSV_MISSING_COLUMNS;
+    }
+
+    // Stop after the last newline; a row still being written waits for the next call
+    const char* from = (begin + offset > rowsBegin) ? begin + offset : rowsBegin;
+    const char* to = LastRowEnd(from, end);
+    LoadStats ignored;
+    if(stats == nullptr)
+    {
+        stats = &ignored;
+    }
+
+    Vector<CsvSpan> rowSpans;
+    records += ParseCsvRows(from, to, columns, out, (spans != nullptr) ? &rowSpans : nullptr, stats);
+    HoldBackRow(to, end, *stats);
+    if(spans != nullptr)
+    {
+        long long shift = from - begin;
+        for(int i = 0; i < rowSpans.GetSize(); i++)
+        {
+            const CsvSpan& span = rowSpans[i];
+            spans->PushBack(CsvSpan(span.year, span.month, span.begin + shift, span.end + shift));
+        }
+    }
+
+    offset = to - begin;
+    return CSV_OK;
+}
+
+// Read one sensor column of a mapped file for a single month
+CsvReadStatus ReadSensorMapped(const string& path, const string& code, const Vector<CsvSpan>& spans,
+                               int year, int month, Vector<SensorSample>& out)
+{
+    MappedFile file;
+    if(!file.Open(path))
+    {
+        return CSV_OPEN_FAILED;
+    }
+
+    const char* begin = file.GetData();
+    const char* end = begin + file.GetSize();
+
+    // Read CSV header and map column indices, plus the requested sensor
+    const char* headerEnd = FindLineEnd(begin, end);
+    const char* rowsBegin = (headerEnd < end) ? headerEnd + 1 : end;
+    if(headerEnd > begin && headerEnd[-1] == '\r')
+    {
+        headerEnd--;
+    }
+
+    Vector<CsvField> header;
+    SplitCsvLine(begin, headerEnd, header);
+
+    CsvColumns columns;
+    MapCsvColumns(header, columns);
+    if(!columns.HasRequired())
+    {
+        return CSV_MISSING_COLUMNS;
+    }
+    for(int i = 0; i < header.GetSize(); i++)
+    {
+        if(header[i].Equals(code.c_str()))
+        {
+            columns.idxExtra = i;
+        }
+    }
+
+    // Without recorded spans (stream-mode load) every row has to be read
+    if(spans.GetSize() == 0)
+    {
+        ParseSensorRows(rowsBegin, end, columns, year, month, out);
+        return CSV_OK;
+    }
+
+    for(int i = 0; i < spans.GetSize(); i++)
+    {
+        const CsvSpan& span = spans[i];
+        if(span.year == year && span.month == month && span.end <= file.GetSize())
+        {
+            ParseSensorRows(begin + span.begin, begin + span.end, columns, year, month, out);
+        }
+    }
+    return CSV_OK;
+}
+
+// Check whether any of three fields is a missing-value marker
+static bool HasSentinel(const string& a, const string& b, const string& c)
+{
+    float value;
+    return ParseNumber(a.data(), static_cast<int>(a.size()), value) == NUMBER_SENTINEL ||
+           ParseNumber(b.data(), static_cast<int>(b.size()), value) == NUMBER_SENTINEL ||
+           ParseNumber(c.data(), static_cast<int>(c.size()), value) == NUMBER_SENTINEL;
+}
+
+// Load one CSV file with getline and stringstream
+CsvReadStatus ReadCsvStream(const string& path, RecPartitions& out, int& records, LoadStats* stats)
+{
+    LoadStats ignored;
+    if(stats == nullptr)
+    {
+        stats = &ignored;
+    }
+
+    ifstream csvFile(path);
+    if(!csvFile.is_open())
+    {
+        return CSV_OPEN_FAILED;
+    }
+
+    // Read CSV header and map column indices
+    string headerLine;
+    getline(csvFile, headerLine);
+    stringstream headerStream(headerLine);
+    string col;
+    Vector<string> columns;
+
+    while(getline(headerStream, col, ','))
+    {
+        columns.Insert(columns.GetSize(), col);
+    }
+
+    int idxWAST = -1, idxWind = -1, idxTemp = -1, idxSolar = -1;
+    for(int i = 0; i < columns.GetSize(); i++)
+    {
+        if(columns[i] == "WAST")
+        {
+            idxWAST = i;
+        }
+        else if(columns[i] == "S")
+        {
+            idxWind = i;
+        }
+        else if(columns[i] == "T")
+        {
+            idxTemp = i;
+        }
+        else if(columns[i] == "SR")
+        {
+            idxSolar = i;
+        }
+    }
+
+    if(idxWAST == -1 || idxWind == -1 || idxTemp == -1 || idxSolar == -1)
+    {
+        csvFile.close();
+        return CSV_MISSING_COLUMNS;
+    }
+
+    // Read each row of CSV (line 1 is the header)
+    string line;
+    long long lineNumber = 1;
+    while(getline(csvFile, line))
+    {
+        lineNumber++;
+        stats->rows++;
+        stringstream ss(line);
+        string token;
+        Vector<string> row;
+
+        while(getline(ss, token, ','))
+        {
+            row.Insert(row.GetSize(), token);
+        }
+
+        if(row.GetSize() != columns.GetSize())
+        {
+            stats->Reject(REJECT_SHORT_ROW, lineNumber);
+            continue;
+        }
+
+        // Parse date and time from WAST
+        string wast = row[idxWAST];
+        int day, month, year, hour, minute;
+        if(sscanf(wast.c_str(), "%d/%d/%d %d:%d", &day, &month, &year, &hour, &minute) != 5)
+        {
+            stats->Reject(REJECT_BAD_TIMESTAMP, lineNumber);
+            continue;
+        }
+
+        // Skip row if any numeric fields are invalid
+        if(!IsValidNumber(row[idxWind]) ||
+                !IsValidNumber(row[idxTemp]) ||
+                !IsValidNumber(row[idxSolar]))
+        {
+            stats->Reject(HasSentinel(row[idxWind], row[idxTemp], row[idxSolar])
+                          ? REJECT_SENTINEL : REJECT_BAD_NUMBER, lineNumber);
+            continue;
+        }
+
+        try
+        {
+            float wind = stof(row[idxWind]) * 3.6f;       // convert m/s to km/h
+            float temp = stof(row[idxTemp]);
+            float solar = stof(row[idxSolar]) * 0.0001667f; // convert W/m2 to kWh/m2
+
+            Date d(day, month, year);
+            Time t(hour, minute);
+            WeatherRec w(d, t, wind, solar, temp);
+
+            AddToPartition(out, year, month, RecNode(w));
+            records++;
+        }
+        catch(const invalid_argument& e)
+        {
+            stats->Reject(REJECT_BAD_TIMESTAMP, lineNumber); // Date rejected day/month/year
+        }
+        catch(const out_of_range& e)
+        {
+            stats->Reject(REJECT_OUT_OF_RANGE, lineNumber);
+        }
+    }
+
+    csvFile.close();
+    return CSV_OK;
+}
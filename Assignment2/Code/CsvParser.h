@@ -0,0 +1,559 @@
+#ifndef CSVPARSER_H_INCLUDED
+#define CSVPARSER_H_INCLUDED
+
+#include <string>
+#include "Map.h"
+#include "EncapVect.h"
+#include "RecNode.h"
+
+using std::string;
+
+/**
+ * @struct CsvField
+ * @brief A non-owning slice of a CSV buffer (string_view style).
+ *
+ * A field simply points into the buffer it was split from, so tokenizing
+ * a row never allocates. The slice is only valid while that buffer is.
+ */
+struct CsvField
+{
+    const char* data;  ///< First character of the field.
+    int length;        ///< Number of characters in the field.
+
+    /**
+     * @brief Constructs an empty field.
+     */
+    CsvField()
+        : data(nullptr), length(0)
+    {
+    }
+
+    /**
+     * @brief Constructs a field over an existing character range.
+     * @param d   First character of the field.
+     * @param len Number of characters.
+     */
+    CsvField(const char* d, int len)
+        : data(d), length(len)
+    {
+    }
+
+    /**
+     * @brief Compares the field with a null-terminated string.
+     * @param text String to compare against.
+     * @return True if both contain exactly the same characters.
+     */
+    bool Equals(const char* text) const;
+
+    /**
+     * @brief Copies the field into an owning string.
+     */
+    string ToString() const;
+};
+
+/**
+ * @struct CsvColumns
+ * @brief Column positions of the fields WeatherLog needs, taken from a CSV header.
+ *
+ * Data files do not share a fixed column order (see MetData-31-3b/c.csv),
+ * so each file's header is mapped before its rows are parsed.
+ */
+struct CsvColumns
+{
+    int count;     ///< Number of columns in the header.
+    int idxWAST;   ///< Index of the WAST timestamp column, or -1.
+    int idxWind;   ///< Index of the wind speed (S) column, or -1.
+    int idxTemp;   ///< Index of the air temperature (T) column, or -1.
+    int idxSolar;  ///< Index of the solar radiation (SR) column, or -1.
+    int idxExtra;  ///< Index of an additional sensor column read on demand, or -1.
+
+    /**
+     * @brief Constructs an empty mapping with every index set to -1.
+     */
+    CsvColumns()
+        : count(0), idxWAST(-1), idxWind(-1), idxTemp(-1), idxSolar(-1), idxExtra(-1)
+    {
+    }
+
+    /**
+     * @brief Checks whether WAST, S, T and SR were all found.
+     */
+    bool HasRequired() const
+    {
+        return idxWAST != -1 && idxWind != -1 && idxTemp != -1 && idxSolar != -1;
+    }
+
+    /**
+     * @brief Index of the rightmost required column.
+     *
+     * A row that ends before this column is rejected as short. The extra
+     * column is not included: a row that ends before it is still a record.
+     */
+    int LastNeeded() const
+    {
+        int last = idxWAST;
+        if(idxWind > last) last = idxWind;
+        if(idxTemp > last) last = idxTemp;
+        if(idxSolar > last) last = idxSolar;
+        return last;
+    }
+
+    /**
+     * @brief Index of the rightmost column read: required or extra.
+     *
+     * Row parsing stops at this column, so the columns after it are
+     * never tokenized.
+     */
+    int LastScanned() const
+    {
+        return (idxExtra > LastNeeded()) ? idxExtra : LastNeeded();
+    }
+};
+
+/**
+ * @brief Outcome of reading one CSV file.
+ */
+enum CsvReadStatus
+{
+    CSV_OK,              ///< File was read; its records were added.
+    CSV_OPEN_FAILED,     ///< File could not be opened.
+    CSV_MISSING_COLUMNS, ///< Header lacks one of WAST, S, T or SR.
+    CSV_TRUNCATED        ///< File is now shorter than the part already read.
+};
+
+/**
+ * @brief Why a data row was not loaded.
+ */
+enum RejectReason
+{
+    REJECT_SHORT_ROW,      ///< Row does not reach every required column (stream mode: wrong field count).
+    REJECT_BAD_TIMESTAMP,  ///< WAST is malformed or holds an invalid date.
+    REJECT_SENTINEL,       ///< A required reading is a missing-value marker or empty.
+    REJECT_BAD_NUMBER,     ///< A required reading is not a number.
+    REJECT_OUT_OF_RANGE,   ///< A required reading overflows or underflows a float.
+    REJECT_UNFINISHED,     ///< Last row of a followed file has no newline yet; read when it is finished.
+    REJECT_DUPLICATE,      ///< Timestamp repeated; resolved by the duplicate policy. Counted without line numbers.
+    REJECT_REASON_COUNT    ///< Number of reasons (not a reason).
+};
+
+/**
+ * @brief Short lower-case name of a reject reason, for reports.
+ */
+const char* RejectReasonName(RejectReason reason);
+
+/**
+ * @brief Offending line numbers kept per reason.
+ */
+const int LOAD_STATS_SAMPLES = 5;
+
+/**
+ * @struct LoadStats
+ * @brief Counts of rows that were not loaded, by reason.
+ *
+ * The parsers only update counters here; nothing is written to the
+ * console while rows are read. For every reason the first few line
+ * numbers (1-based, the header being line 1) are kept as a sample.
+ * Duplicates are found when the files' runs are merged, after the line
+ * numbers are gone, so they are counted without a sample (AddRejects()).
+ */
+struct LoadStats
+{
+    long long rows;                              ///< Data rows examined.
+    long long rejects[REJECT_REASON_COUNT];      ///< Rows rejected, by reason.
+    Vector<long long> lines[REJECT_REASON_COUNT]; ///< First rejected line numbers, by reason.
+
+    /**
+     * @brief Constructs empty statistics.
+     */
+    LoadStats();
+
+    /**
+     * @brief Counts one rejected row.
+     * @param reason Why the row was rejected.
+     * @param line   Line number of the row, or 0 if unknown.
+     */
+    void Reject(RejectReason reason, long long line);
+
+    /**
+     * @brief Counts several rejected rows whose line numbers are not known.
+     *
+     * Used for duplicates, which are found when runs are merged (see
+     * MergeSortedRuns()), after the rows' line numbers are gone.
+     *
+     * @param reason Why the rows were rejected.
+     * @param count  Number of rows.
+     */
+    void AddRejects(RejectReason reason, long long count);
+
+    /**
+     * @brief Takes back one rejected row, so it can be counted again.
+     *
+     * Used for a held-back unfinished row (REJECT_UNFINISHED) just before
+     * it is read a second time.
+     *
+     * @param reason Why the row was rejected.
+     * @param line   Line number of the row, removed from the sample if present.
+     */
+    void Withdraw(RejectReason reason, long long line);
+
+    /**
+     * @brief Adds another set of statistics to this one.
+     *
+     * Used to join the chunks of a file in order, so the kept samples are
+     * still the first lines of the file.
+     *
+     * @param other      Statistics to add.
+     * @param lineOffset Added to the line numbers of @p other.
+     */
+    void Add(const LoadStats& other, long long lineOffset);
+
+    /**
+     * @brief Total number of rejected rows, over all reasons.
+     */
+    long long TotalRejects() const;
+};
+
+/**
+ * @brief Records parsed from CSV files, grouped as partitions[year][month].
+ *
+ * Records are kept in file order; WeatherLog sorts each month by time
+ * (see SortPartitions()) and then turns it into a BST or columns.
+ */
+typedef Map<int, Map<int, Vector<RecNode>>> RecPartitions;
+
+/**
+ * @struct CsvSpan
+ * @brief Byte range of a CSV file whose records all belong to one month.
+ *
+ * Recorded while a file is loaded, so that a column which was not loaded
+ * can later be read for one month without scanning the whole file. Rows
+ * inside the range that were skipped at load time are skipped again.
+ */
+struct CsvSpan
+{
+    int year;        ///< Year of the records in the range.
+    int month;       ///< Month of the records in the range.
+    long long begin; ///< Offset of the first row.
+    long long end;   ///< Offset just past the last row.
+
+    /**
+     * @brief Constructs an empty range.
+     */
+    CsvSpan()
+        : year(0), month(0), begin(0), end(0)
+    {
+    }
+
+    /**
+     * @brief Constructs a range for the given month.
+     */
+    CsvSpan(int y, int m, long long b, long long e)
+        : year(y), month(m), begin(b), end(e)
+    {
+    }
+};
+
+/**
+ * @struct SensorSample
+ * @brief One value of an additional sensor column, keyed by its timestamp.
+ */
+struct SensorSample
+{
+    unsigned long long key; ///< Timestamp packed by PackDateTime().
+    float value;            ///< Sensor reading, or NaN if missing or invalid.
+
+    /**
+     * @brief Constructs an empty sample.
+     */
+    SensorSample()
+        : key(0), value(0)
+    {
+    }
+
+    /**
+     * @brief Constructs a sample from a packed timestamp and a value.
+     */
+    SensorSample(unsigned long long k, float v)
+        : key(k), value(v)
+    {
+    }
+};
+
+/**
+ * @brief Checks if a string represents a valid numeric value.
+ *
+ * Rejects empty strings and the missing-value sentinels NA, N/A, --- and
+ * -9999 (case-insensitive).
+ *
+ * @param s String to check.
+ * @return True if @p s is a plain decimal number with optional exponent.
+ */
+bool IsValidNumber(const string& s);
+
+/**
+ * @brief Checks if a character range represents a valid numeric value.
+ *
+ * Same rules as IsValidNumber(const string&) but without allocating.
+ *
+ * @param s      First character.
+ * @param length Number of characters.
+ */
+bool IsValidNumber(const char* s, int length);
+
+/**
+ * @brief Result of converting a numeric CSV field.
+ */
+enum NumberStatus
+{
+    NUMBER_OK,            ///< Field holds a valid number; the value was stored.
+    NUMBER_SENTINEL,      ///< Field is a missing-value marker (NA, N/A, ---, -9999) or empty.
+    NUMBER_INVALID,       ///< Field is not a plain decimal number.
+    NUMBER_OUT_OF_RANGE   ///< Number overflows or underflows a float.
+};
+
+/**
+ * @brief Validates and converts a numeric field in a single pass.
+ *
+ * Accepts exactly what IsValidNumber() accepts - an optional sign, digits
+ * with at most one '.', and an optional exponent - and converts it without
+ * allocating, without consulting the C locale and without exceptions.
+ * The sentinels are recognised case-insensitively in place.
+ *
+ * Numbers with up to 7 significant digits and a decimal exponent within
+ * +/-10 (every value in the MetData files) are converted exactly as
+ * strtof() would, with one float multiply or divide.
+ *
+ * @param s      First character of the field.
+ * @param length Number of characters.
+ * @param value  Receives the number when NUMBER_OK is returned.
+ * @return NUMBER_OK, or why the field does not hold a usable number.
+ */
+NumberStatus ParseNumber(const char* s, int length, float& value);
+
+/**
+ * @brief Result of decoding a WAST timestamp field.
+ */
+enum WastStatus
+{
+    WAST_OK,          ///< Timestamp decoded; the packed key was stored.
+    WAST_BAD_FORMAT,  ///< Field does not match "d/m/yyyy h:mm".
+    WAST_BAD_DATE     ///< Field matches, but day, month or year is out of range.
+};
+
+/**
+ * @brief Longest date prefix ("dd/mm/yyyy") remembered between rows.
+ */
+const int WAST_PREFIX_MAX = 24;
+
+/**
+ * @struct WastCache
+ * @brief The date part of the previously decoded WAST field.
+ *
+ * Consecutive rows are normally minutes apart and share the same date
+ * text, so ParseWast() compares the start of each field with the cached
+ * bytes and only re-parses the date when they differ.
+ */
+struct WastCache
+{
+    char prefix[WAST_PREFIX_MAX];  ///< Date text of the previous field, up to the end of the year.
+    int prefixLength;              ///< Length of @p prefix; 0 when nothing is cached.
+    int day;                       ///< Decoded day of the cached date.
+    int month;                     ///< Decoded month of the cached date.
+    int year;                      ///< Decoded year of the cached date.
+    bool dateValid;                ///< True if the cached date is a valid Date.
+
+    /**
+     * @brief Constructs an empty cache.
+     */
+    WastCache()
+        : prefixLength(0), day(0), month(0), year(0), dateValid(false)
+    {
+    }
+};
+
+/**
+ * @brief Decodes a WAST field such as "31/3/2016 9:00" or "31/03/2016 9:00".
+ *
+ * Accepts the same input as sscanf(field, "%d/%d/%d %d:%d") - leading
+ * whitespace before each number, optional signs, anything after the
+ * minutes - but writes the timestamp directly as a packed key instead of
+ * going through Date and Time. Validation matches those classes: an
+ * invalid day, month or year is reported as WAST_BAD_DATE, while an
+ * out-of-range hour or minute is stored as 0.
+ *
+ * @param s      First character of the field.
+ * @param length Number of characters.
+ * @param cache  Date of the previous row; reused when the date text matches, then updated.
+ * @param key    Receives the timestamp packed by PackDateTime() when WAST_OK is returned.
+ * @return WAST_OK, or why the field could not be used.
+ */
+WastStatus ParseWast(const char* s, int length, WastCache& cache, unsigned long long& key);
+
+/**
+ * @brief Splits one CSV line into fields on ','.
+ *
+ * Fields are slices of the input range; nothing is copied. Splitting
+ * follows getline(ss, token, ',') exactly: an empty line has no fields
+ * and a trailing comma does not produce a trailing empty field.
+ *
+ * @param begin  First character of the line.
+ * @param end    One past the last character (excluding the newline).
+ * @param fields Cleared, then filled with the fields of the line.
+ */
+void SplitCsvLine(const char* begin, const char* end, Vector<CsvField>& fields);
+
+/**
+ * @brief Locates the WAST, S, T and SR columns in a header row.
+ * @param header  Header fields.
+ * @param columns Receives the column count and indices.
+ */
+void MapCsvColumns(const Vector<CsvField>& header, CsvColumns& columns);
+
+/**
+ * @brief Parses the data rows of a mapped CSV buffer into partitions.
+ *
+ * Rows are split in place and only up to the rightmost of the WAST, S, T
+ * and SR columns; the remaining columns are skipped without being looked
+ * at. The numeric fields are converted with ParseNumber(). Rows too short
+ * to hold every required column, or with an unparsable timestamp or
+ * invalid numbers, are skipped. Unlike ReadCsvStream(), a row whose
+ * unused trailing columns are missing or extra is still accepted.
+ *
+ * @param begin   First character after the header line.
+ * @param end     End of the buffer.
+ * @param columns Column mapping derived from the file's header.
+ * @param out     Partitions that receive the parsed records.
+ * @param spans   If not null, receives the month ranges of the records, as offsets from @p begin.
+ * @param stats   If not null, receives the rejected rows; line numbers count from 1 at @p begin.
+ * @return Number of records added to @p out.
+ */
+int ParseCsvRows(const char* begin, const char* end, const CsvColumns& columns, RecPartitions& out,
+                 Vector<CsvSpan>* spans = nullptr, LoadStats* stats = nullptr);
+
+/**
+ * @brief Parses the data rows of a mapped CSV buffer on several threads.
+ *
+ * The buffer is cut into byte ranges whose boundaries are moved forward
+ * to the next newline, so every row lies entirely inside one chunk. Each
+ * chunk is parsed by ParseCsvRows() into its own partitions, and the chunk
+ * partitions are then appended to @p out in chunk order. The result is
+ * therefore identical to a single ParseCsvRows() call over the buffer.
+ *
+ * Buffers smaller than a few chunks are parsed serially.
+ *
+ * @param begin   First character after the header line.
+ * @param end     End of the buffer.
+ * @param columns Column mapping derived from the file's header.
+ * @param out     Partitions that receive the parsed records.
+ * @param threads Maximum worker threads (0 = hardware concurrency, 1 = serial).
+ * @param spans   If not null, receives the month ranges of the records, as offsets from @p begin.
+ * @param stats   If not null, receives the rejected rows; line numbers count from 1 at @p begin.
+ * @return Number of records added to @p out.
+ */
+int ParseCsvRowsChunked(const char* begin, const char* end, const CsvColumns& columns,
+                        RecPartitions& out, int threads, Vector<CsvSpan>* spans = nullptr,
+                        LoadStats* stats = nullptr);
+
+/**
+ * @brief Reads the extra sensor column of the rows that fall in one month.
+ *
+ * Rows are accepted exactly as ParseCsvRows() accepts them, so every
+ * record loaded for the month yields one sample, in file order. The
+ * sample value is NaN when the row's sensor field is missing or not a
+ * valid number, or when @p columns has no extra column. Skipped rows are
+ * not counted again; they were counted when the file was loaded.
+ *
+ * @param begin   First character of the rows to read.
+ * @param end     End of the rows to read.
+ * @param columns Column mapping, with idxExtra set to the sensor column.
+ * @param year    Year of the records to keep.
+ * @param month   Month of the records to keep.
+ * @param out     Receives one sample per record of that month.
+ * @return Number of samples added to @p out.
+ */
+int ParseSensorRows(const char* begin, const char* end, const CsvColumns& columns,
+                    int year, int month, Vector<SensorSample>& out);
+
+/**
+ * @brief Reads a CSV file line by line with getline and stringstream.
+ *
+ * This is the original loader, kept as the reference implementation.
+ * Neither reader writes to the console, so several files can be read on
+ * worker threads at once; the caller reports the returned status and the
+ * rejected rows collected in @p stats.
+ *
+ * @param path    Path of the CSV file.
+ * @param out     Partitions that receive the parsed records.
+ * @param records Incremented by the number of records added.
+ * @param stats   If not null, receives the rejected rows.
+ * @return CSV_OK, or the reason the file was not read.
+ */
+CsvReadStatus ReadCsvStream(const string& path, RecPartitions& out, int& records, LoadStats* stats = nullptr);
+
+/**
+ * @brief Reads a CSV file through a memory mapping, without per-field allocation.
+ *
+ * Produces the same partitions as ReadCsvStream(), except that a row
+ * whose field count differs from the header is still loaded if it
+ * reaches every required column (see ParseCsvRows()); ReadCsvStream()
+ * rejects it. A trailing '\r' is stripped from every line so Windows
+ * line endings parse the same way they do through a text-mode stream.
+ *
+ * Large files are split into newline-aligned chunks that are parsed
+ * concurrently (see ParseCsvRowsChunked()).
+ *
+ * @param path    Path of the CSV file.
+ * @param out     Partitions that receive the parsed records.
+ * @param records Incremented by the number of records added.
+ * @param threads Maximum worker threads for this file (default: 1, serial).
+ * @param spans   If not null, receives the month ranges of the records, as file offsets.
+ * @param stats   If not null, receives the rejected rows.
+ * @param readTo  If not null, the file is followed: parsing stops after the last newline,
+ *                and this receives that offset. A final row without a newline is left
+ *                for ReadCsvAppended() and counted in @p stats as REJECT_UNFINISHED.
+ * @return CSV_OK, or the reason the file was not read.
+ */
+CsvReadStatus ReadCsvMapped(const string& path, RecPartitions& out, int& records, int threads = 1,
+                            Vector<CsvSpan>* spans = nullptr, LoadStats* stats = nullptr,
+                            long long* readTo = nullptr);
+
+/**
+ * @brief Reads only the rows appended to a CSV file since it was last read.
+ *
+ * Parsing starts at @p offset (or after the header when @p offset is 0)
+ * and stops after the last complete, newline-terminated row, so a row
+ * that is still being written is left for the next call and counted as
+ * REJECT_UNFINISHED. @p offset is then moved past the rows that were read.
+ *
+ * @param path    Path of the CSV file.
+ * @param offset  File offset already read; updated on return.
+ * @param out     Partitions that receive the parsed records.
+ * @param records Incremented by the number of records added.
+ * @param spans   If not null, receives the month ranges of the new records, as file offsets.
+ * @param stats   If not null, receives the rejected rows; line numbers count from 1 at @p offset.
+ * @return CSV_OK, or the reason the file was not read.
+ */
+CsvReadStatus ReadCsvAppended(const string& path, long long& offset, RecPartitions& out, int& records,
+                              Vector<CsvSpan>* spans = nullptr, LoadStats* stats = nullptr);
+
+/**
+ * @brief Reads one sensor column of a CSV file for a single month.
+ *
+ * The file is mapped again and only the byte ranges that @p spans lists
+ * for the month are parsed; when @p spans is empty (the file was loaded
+ * with ReadCsvStream()) every row is parsed instead. If the file has no
+ * column named @p code, the samples are still produced, with NaN values,
+ * so they line up with the loaded records.
+ *
+ * @param path  Path of the CSV file.
+ * @param code  Header name of the sensor column, e.g. "DP" or "RH".
+ * @param spans Month ranges recorded when the file was loaded.
+ * @param year  Year to read.
+ * @param month Month to read.
+ * @param out   Receives one sample per record of that month, in file order.
+ * @return CSV_OK, or the reason the file was not read.
+ */
+CsvReadStatus ReadSensorMapped(const string& path, const string& code, const Vector<CsvSpan>& spans,
+                               int year, int month, Vector<SensorSample>& out);
+
+#endif // CSVPARSER_H_INCLUDED
@@ -0,0 +1,460 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include "CsvParser.h"
+using namespace std;
+
+// Small wrapper to display [OK] / [FAIL] for each test condition
+void Assert(bool condition, const string& message)
+{
+    if (!condition)
+    {
+        cout << "[FAIL] " << message << endl;
+    }
+    else
+    {
+        cout << "[OK] " << message << endl;
+    }
+}
+
+// Parses a whole string with ParseNumber
+NumberStatus Parse(const string& s, float& value)
+{
+    return ParseNumber(s.data(), static_cast<int>(s.size()), value);
+}
+
+// Reference conversion: the old IsValidNumber + stof route
+bool ReferenceValid(const string& s, float& value, bool& outOfRange)
+{
+    outOfRange = false;
+    if (!IsValidNumber(s))
+    {
+        return false;
+    }
+    errno = 0;
+    value = strtof(s.c_str(), nullptr);
+    outOfRange = (errno == ERANGE);
+    return true;
+}
+
+// Verifies plain numbers found in the MetData files
+void TestPlainNumbers()
+{
+    cout << "\n=== TestPlainNumbers ===\n";
+    float v = 0;
+
+    Assert(Parse("20.74", v) == NUMBER_OK && v == 20.74f, "20.74");
+    Assert(Parse("1013.4", v) == NUMBER_OK && v == 1013.4f, "1013.4");
+    Assert(Parse("-3", v) == NUMBER_OK && v == -3.0f, "-3");
+    Assert(Parse("+4", v) == NUMBER_OK && v == 4.0f, "+4");
+    Assert(Parse(".5", v) == NUMBER_OK && v == 0.5f, ".5");
+    Assert(Parse("5.", v) == NUMBER_OK && v == 5.0f, "5.");
+    Assert(Parse("1e3", v) == NUMBER_OK && v == 1000.0f, "1e3");
+    Assert(Parse("2.5E-2", v) == NUMBER_OK && v == 0.025f, "2.5E-2");
+}
+
+// Verifies missing-value markers
+void TestSentinels()
+{
+    cout << "\n=== TestSentinels ===\n";
+    float v = 0;
+
+    Assert(Parse("", v) == NUMBER_SENTINEL, "Empty field");
+    Assert(Parse("NA", v) == NUMBER_SENTINEL, "NA");
+    Assert(Parse("na", v) == NUMBER_SENTINEL, "na");
+    Assert(Parse("N/A", v) == NUMBER_SENTINEL, "N/A");
+    Assert(Parse("---", v) == NUMBER_SENTINEL, "---");
+    Assert(Parse("-9999", v) == NUMBER_SENTINEL, "-9999");
+    Assert(Parse("-9999.0", v) == NUMBER_OK && v == -9999.0f, "-9999.0 is a number");
+}
+
+// Verifies malformed and out-of-range numbers
+void TestRejects()
+{
+    cout << "\n=== TestRejects ===\n";
+    float v = 0;
+
+    Assert(Parse("abc", v) == NUMBER_INVALID, "Letters");
+    Assert(Parse("1.2.3", v) == NUMBER_INVALID, "Two dots");
+    Assert(Parse("1e", v) == NUMBER_INVALID, "Exponent without digits");
+    Assert(Parse("1e+", v) == NUMBER_INVALID, "Signed exponent without digits");
+    Assert(Parse("e5", v) == NUMBER_INVALID, "Exponent without mantissa");
+    Assert(Parse("--5", v) == NUMBER_INVALID, "Double sign");
+    Assert(Parse(" 7", v) == NUMBER_INVALID, "Leading space");
+    Assert(Parse("1e50", v) == NUMBER_OUT_OF_RANGE, "Overflow");
+    Assert(Parse("1e-50", v) == NUMBER_OUT_OF_RANGE, "Underflow");
+}
+
+// Compares ParseNumber with IsValidNumber + strtof on random fields
+void TestAgainstReference()
+{
+    cout << "\n=== TestAgainstReference ===\n";
+    const char alphabet[] = "0123456789012345678901234567890123456789.-+eENA/";
+    srand(283);
+
+    int mismatches = 0;
+    for (int trial = 0; trial < 200000; trial++)
+    {
+        string s;
+        int length = 1 + rand() % 9;
+        for (int i = 0; i < length; i++)
+        {
+            s += alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+
+        float expected = 0, actual = 0;
+        bool outOfRange = false;
+        bool valid = ReferenceValid(s, expected, outOfRange);
+        NumberStatus status = Parse(s, actual);
+
+        bool same;
+        if (!valid)
+        {
+            same = (status == NUMBER_SENTINEL || status == NUMBER_INVALID);
+        }
+        else if (outOfRange)
+        {
+            same = (status == NUMBER_OUT_OF_RANGE);
+        }
+        else
+        {
+            same = (status == NUMBER_OK && memcmp(&expected, &actual, sizeof(float)) == 0);
+        }
+
+        if (!same && mismatches++ < 5)
+        {
+            cout << "  mismatch on \"" << s << "\"" << endl;
+        }
+    }
+    Assert(mismatches == 0, "ParseNumber matches IsValidNumber + strtof on 200000 random fields");
+}
+
+// Decodes a whole string with ParseWast
+WastStatus Wast(const string& s, WastCache& cache, unsigned long long& key)
+{
+    return ParseWast(s.data(), static_cast<int>(s.size()), cache, key);
+}
+
+// Verifies both WAST date styles and the packed result
+void TestWastFormats()
+{
+    cout << "\n=== TestWastFormats ===\n";
+    WastCache cache;
+    unsigned long long key = 0;
+
+    Assert(Wast("31/3/2016 9:00", cache, key) == WAST_OK && key == PackDateTime(2016, 3, 31, 9, 0),
+           "31/3/2016 9:00");
+    Assert(Wast("31/03/2016 9:10", cache, key) == WAST_OK && key == PackDateTime(2016, 3, 31, 9, 10),
+           "31/03/2016 9:10");
+    Assert(Wast("1/1/2007 25:61", cache, key) == WAST_OK && key == PackDateTime(2007, 1, 1, 0, 0),
+           "Out-of-range time stored as 00:00");
+    Assert(Wast("32/1/2007 1:00", cache, key) == WAST_BAD_DATE, "Day 32 rejected");
+    Assert(Wast("1/13/2007 1:00", cache, key) == WAST_BAD_DATE, "Month 13 rejected");
+    Assert(Wast("1/1/2007", cache, key) == WAST_BAD_FORMAT, "Missing time rejected");
+    Assert(Wast("x/1/2007 1:00", cache, key) == WAST_BAD_FORMAT, "Non-numeric day rejected");
+}
+
+// Verifies that the cached date is reused only for the same date text
+void TestWastCache()
+{
+    cout << "\n=== TestWastCache ===\n";
+    WastCache cache;
+    unsigned long long key = 0;
+
+    Wast("31/3/2016 9:00", cache, key);
+    Assert(cache.prefixLength == 9, "Date prefix cached");
+
+    Assert(Wast("31/3/2016 23:50", cache, key) == WAST_OK && key == PackDateTime(2016, 3, 31, 23, 50),
+           "Cached date reused");
+    Assert(Wast("31/3/20160 1:00", cache, key) == WAST_OK && key == PackDateTime(20160, 3, 31, 1, 0),
+           "Longer year is not mistaken for the cached date");
+    Assert(Wast("1/4/2016 0:00", cache, key) == WAST_OK && key == PackDateTime(2016, 4, 1, 0, 0),
+           "New date replaces the cache");
+}
+
+// Compares ParseWast with sscanf("%d/%d/%d %d:%d") on random fields
+void TestWastAgainstSscanf()
+{
+    cout << "\n=== TestWastAgainstSscanf ===\n";
+    const char separators[] = "//// ::-+x";
+    srand(283);
+
+    WastCache cache;
+    int mismatches = 0;
+    for (int trial = 0; trial < 200000; trial++)
+    {
+        // Short digit runs (no int overflow) mixed with format characters
+        string s;
+        int pieces = 3 + rand() % 8;
+        for (int i = 0; i < pieces; i++)
+        {
+            if (rand() % 2 == 0)
+            {
+                s += to_string(rand() % 3000);
+            }
+            else
+            {
+                s += separators[rand() % (sizeof(separators) - 1)];
+            }
+        }
+
+        int d = 0, m = 0, y = 0, h = 0, mi = 0;
+        bool scanned = (sscanf(s.c_str(), "%d/%d/%d %d:%d", &d, &m, &y, &h, &mi) == 5);
+
+        unsigned long long key = 0;
+        WastStatus status = Wast(s, cache, key);
+
+        bool same;
+        if (!scanned)
+        {
+            same = (status == WAST_BAD_FORMAT);
+        }
+        else if (d < 1 || d > 31 || m < 1 || m > 12 || y <= 0)
+        {
+            same = (status == WAST_BAD_DATE);
+        }
+        else
+        {
+            h = (h >= 0 && h < 24) ? h : 0;
+            mi = (mi >= 0 && mi < 60) ? mi : 0;
+            same = (status == WAST_OK && key == PackDateTime(y, m, d, h, mi));
+        }
+
+        if (!same && mismatches++ < 5)
+        {
+            cout << "  mismatch on \"" << s << "\"" << endl;
+        }
+    }
+    Assert(mismatches == 0, "ParseWast matches sscanf on 200000 random fields");
+}
+
+// Verifies getline-compatible splitting of a line
+void TestSplitCsvLine()
+{
+    cout << "\n=== TestSplitCsvLine ===\n";
+    Vector<CsvField> fields;
+    string line = "WAST,S,,T";
+
+    SplitCsvLine(line.data(), line.data() + line.size(), fields);
+    Assert(fields.GetSize() == 4 && fields[0].Equals("WAST") && fields[2].length == 0,
+           "Empty field between commas kept");
+
+    line = "a,b,";
+    SplitCsvLine(line.data(), line.data() + line.size(), fields);
+    Assert(fields.GetSize() == 2, "Trailing comma adds no field");
+
+    SplitCsvLine(line.data(), line.data(), fields);
+    Assert(fields.GetSize() == 0, "Empty line has no fields");
+}
+
+// Verifies that rows are parsed only up to the rightmost required column
+void TestProjection()
+{
+    cout << "\n=== TestProjection ===\n";
+    Vector<CsvField> header;
+    string headerLine = "WAST,S,SR,T,RH,Sx";
+    SplitCsvLine(headerLine.data(), headerLine.data() + headerLine.size(), header);
+
+    CsvColumns columns;
+    MapCsvColumns(header, columns);
+    Assert(columns.LastNeeded() == 3, "Rightmost required column is T");
+
+    string rows = "1/1/2007 0:00,1,2,3,4,5\r\n"
+                  "1/1/2007 0:10,1,2,3\n"
+                  "1/1/2007 0:20,1,2,3,4,5,6,7\n"
+                  "1/1/2007 0:30,1,2\n"
+                  "1/1/2007 0:40,1,2,\n";
+    RecPartitions out;
+    int records = ParseCsvRows(rows.data(), rows.data() + rows.size(), columns, out);
+    Assert(records == 3, "Unused trailing columns may be missing or extra");
+    Assert(out[2007][1][1].rec.GetAmbAirTemp() == 3.0f, "Last required field ends at the line end");
+}
+
+// Verifies month spans and reading an extra column back through them
+void TestSensorSpans()
+{
+    cout << "\n=== TestSensorSpans ===\n";
+    Vector<CsvField> header;
+    string headerLine = "WAST,DP,S,SR,T";
+    SplitCsvLine(headerLine.data(), headerLine.data() + headerLine.size(), header);
+
+    CsvColumns columns;
+    MapCsvColumns(header, columns);
+
+    string rows = "31/1/2007 23:50,4,1,2,3\n"
+                  "1/2/2007 0:00,5,1,2,3\n"
+                  "bad row\n"
+                  "1/2/2007 0:10,NA,1,2,3\n"
+                  "1/3/2007 0:00,7,1,2,3\n";
+    RecPartitions out;
+    Vector<CsvSpan> spans;
+    ParseCsvRows(rows.data(), rows.data() + rows.size(), columns, out, &spans);
+    Assert(spans.GetSize() == 3 && spans[1].month == 2, "One span per run of a month");
+
+    columns.idxExtra = 1;
+    Vector<SensorSample> samples;
+    const CsvSpan& feb = spans[1];
+    ParseSensorRows(rows.data() + feb.begin, rows.data() + feb.end, columns, 2007, 2, samples);
+    Assert(samples.GetSize() == 2 && samples[0].value == 5.0f, "Span holds the month's rows");
+    Assert(samples[1].value != samples[1].value, "Missing reading stored as NaN");
+
+    // A row that stops before the sensor column is still a record
+    string shortRows = "1/2/2007 0:20,1,2,3,8\n"
+                       "1/2/2007 0:30,1,2,3\n"
+                       "1/2/2007 0:40,1,2,3,9,10\n";
+    CsvColumns trailing;
+    string trailingHeader = "WAST,S,SR,T,DP";
+    SplitCsvLine(trailingHeader.data(), trailingHeader.data() + trailingHeader.size(), header);
+    MapCsvColumns(header, trailing);
+    RecPartitions loaded;
+    int records = ParseCsvRows(shortRows.data(), shortRows.data() + shortRows.size(), trailing, loaded);
+
+    trailing.idxExtra = 4;
+    samples.Clear();
+    int read = ParseSensorRows(shortRows.data(), shortRows.data() + shortRows.size(), trailing, 2007, 2, samples);
+    Assert(records == 3 && read == 3, "One sample per loaded record");
+    Assert(samples[0].value == 8.0f && samples[1].value != samples[1].value && samples[2].value == 9.0f,
+           "Row ending before the sensor column gives NaN");
+}
+
+// Verifies that rejected rows are counted by reason with their line numbers
+void TestLoadStats()
+{
+    cout << "\n=== TestLoadStats ===\n";
+    Vector<CsvField> header;
+    string headerLine = "WAST,S,SR,T";
+    SplitCsvLine(headerLine.data(), headerLine.data() + headerLine.size(), header);
+
+    CsvColumns columns;
+    MapCsvColumns(header, columns);
+
+    string rows = "1/1/2007 0:00,1,2,3\n"
+                  "1/1/2007 0:10,1\n"
+                  "32/1/2007 0:20,1,2,3\n"
+                  "1/1/2007 0:30,NA,2,3\n"
+                  "1/1/2007 0:40,x,2,3\n"
+                  "1/1/2007 0:50,1e50,2,3\n";
+    RecPartitions out;
+    LoadStats stats;
+    int records = ParseCsvRows(rows.data(), rows.data() + rows.size(), columns, out, nullptr, &stats);
+
+    Assert(records == 1 && stats.rows == 6 && stats.TotalRejects() == 5, "Every row counted once");
+    Assert(stats.rejects[REJECT_SHORT_ROW] == 1 && stats.lines[REJECT_SHORT_ROW][0] == 2, "Short row");
+    Assert(stats.rejects[REJECT_BAD_TIMESTAMP] == 1 && stats.lines[REJECT_BAD_TIMESTAMP][0] == 3, "Bad timestamp");
+    Assert(stats.rejects[REJECT_SENTINEL] == 1 && stats.lines[REJECT_SENTINEL][0] == 4, "Missing value");
+    Assert(stats.rejects[REJECT_BAD_NUMBER] == 1 && stats.lines[REJECT_BAD_NUMBER][0] == 5, "Invalid number");
+    Assert(stats.rejects[REJECT_OUT_OF_RANGE] == 1 && stats.lines[REJECT_OUT_OF_RANGE][0] == 6, "Out-of-range value");
+
+    // A second chunk is appended with its lines shifted; the sample stays bounded
+    LoadStats total;
+    total.Add(stats, 1);
+    for(int i = 0; i < 10; i++)
+    {
+        total.Reject(REJECT_SHORT_ROW, 100 + i);
+    }
+    Assert(total.lines[REJECT_SHORT_ROW][0] == 3, "Line numbers shifted by the offset");
+    Assert(total.rejects[REJECT_SHORT_ROW] == 11 && total.lines[REJECT_SHORT_ROW].GetSize() == LOAD_STATS_SAMPLES,
+           "Sample limited to the first lines");
+
+    // Duplicates are added as one count, without lines
+    total.AddRejects(REJECT_DUPLICATE, 180);
+    Assert(total.rejects[REJECT_DUPLICATE] == 180 && total.lines[REJECT_DUPLICATE].GetSize() == 0 &&
+           total.TotalRejects() == 15 + 180, "Duplicates counted in one call");
+}
+
+// Verifies that only complete rows appended since the last read are parsed
+void TestReadAppended()
+{
+    cout << "\n=== TestReadAppended ===\n";
+    const char* path = "CsvParserTest_tail.csv";
+    FILE* f = fopen(path, "wb");
+    fputs("WAST,S,SR,T\n1/1/2007 0:00,1,2,3\n1/1/2007 0:1", f);
+    fclose(f);
+
+    RecPartitions out;
+    long long offset = 0;
+    int records = 0;
+    ReadCsvAppended(path, offset, out, records);
+    Assert(records == 1 && offset == 32, "Row still being written is left for later");
+
+    f = fopen(path, "ab");
+    fputs("0,4,5,6\n1/2/2007 0:00,7,8,9\n", f);
+    fclose(f);
+
+    ReadCsvAppended(path, offset, out, records);
+    Assert(records == 3 && out[2007][1].GetSize() == 2 && out[2007][2].GetSize() == 1,
+           "Appended rows go to their own months");
+    Assert(ReadCsvAppended(path, offset, out, records) == CSV_OK && records == 3, "Nothing new to read");
+
+    offset += 100;
+    Assert(ReadCsvAppended(path, offset, out, records) == CSV_TRUNCATED, "Shrunk file detected");
+    remove(path);
+}
+
+// Verifies that a followed mapped load leaves a half-written last row to the next poll
+void TestMappedFollow()
+{
+    cout << "\n=== TestMappedFollow ===\n";
+    const char* path = "CsvParserTest_follow.csv";
+    FILE* f = fopen(path, "wb");
+    fputs("WAST,S,SR,T\n1/1/2007 0:00,1,2,3\n1/1/2007 0:10,4,5,1", f);
+    fclose(f);
+
+    RecPartitions out;
+    int records = 0;
+    long long readTo = -1;
+    LoadStats held;
+    ReadCsvMapped(path, out, records, 1, nullptr, &held, &readTo);
+    Assert(records == 1 && readTo == 32, "Unfinished row not loaded by a followed load");
+    Assert(held.rows == 2 && held.rejects[REJECT_UNFINISHED] == 1 && held.lines[REJECT_UNFINISHED].GetSize() == 1 &&
+           held.lines[REJECT_UNFINISHED][0] == 3, "Unfinished row counted, with its line");
+    held.Withdraw(REJECT_UNFINISHED, 3);
+    Assert(held.rows == 1 && held.TotalRejects() == 0 && held.lines[REJECT_UNFINISHED].GetSize() == 0,
+           "Withdrawn row uncounted");
+
+    LoadStats still;
+    long long offset = readTo;
+    ReadCsvAppended(path, offset, out, records, nullptr, &still);
+    Assert(records == 1 && offset == readTo && still.rows == 1 && still.rejects[REJECT_UNFINISHED] == 1,
+           "Row still unfinished on the next read");
+
+    f = fopen(path, "ab");
+    fputs("7\n", f);
+    fclose(f);
+
+    LoadStats stats;
+    ReadCsvAppended(path, readTo, out, records, nullptr, &stats);
+    Assert(records == 2 && out[2007][1].GetSize() == 2 && out[2007][1][1].rec.GetAmbAirTemp() == 17.0f,
+           "Finished row read once, with its complete value");
+    Assert(stats.rows == 1 && stats.TotalRejects() == 0, "Row counted once, nothing rejected");
+
+    // Without following, the whole file is read
+    RecPartitions all;
+    records = 0;
+    ReadCsvMapped(path, all, records);
+    Assert(records == 2, "Unfollowed load reads to the end");
+    remove(path);
+}
+
+int main()
+{
+    TestPlainNumbers();
+    TestSentinels();
+    TestRejects();
+    TestAgainstReference();
+    TestWastFormats();
+    TestWastCache();
+    TestWastAgainstSscanf();
+    TestSplitCsvLine();
+    TestProjection();
+    TestSensorSpans();
+    TestLoadStats();
+    TestReadAppended();
+    TestMappedFollow();
+
+    cout << "\n=== ALL TESTS COMPLETE ===\n";
+    return 0;
+}
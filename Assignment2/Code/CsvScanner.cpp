@@ -0,0 +1,124 @@
+#include "CsvScanner.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define CSV_SCAN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CSV_SCAN_SSE2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Index of the lowest set bit of a non-zero mask
+static inline int LowestBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+#if defined(CSV_SCAN_AVX2)
+
+// Bit i is set if p[i] is ',' or '\n' (one 32-byte AVX2 compare)
+static inline unsigned int DelimiterMask(const char* p)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, comma), _mm256_cmpeq_epi8(block, newline));
+    return static_cast<unsigned int>(_mm256_movemask_epi8(hits));
+}
+
+#elif defined(CSV_SCAN_SSE2)
+
+// Bit i is set if p[i] is ',' or '\n' (two 16-byte SSE2 compares)
+static inline unsigned int DelimiterMask(const char* p)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16));
+    __m128i loHits = _mm_or_si128(_mm_cmpeq_epi8(lo, comma), _mm_cmpeq_epi8(lo, newline));
+    __m128i hiHits = _mm_or_si128(_mm_cmpeq_epi8(hi, comma), _mm_cmpeq_epi8(hi, newline));
+
+    unsigned int loMask = static_cast<unsigned int>(_mm_movemask_epi8(loHits));
+    unsigned int hiMask = static_cast<unsigned int>(_mm_movemask_epi8(hiHits));
+    return loMask | (hiMask << 16);
+}
+
+#else
+
+// Bit i is set if p[i] is ',' or '\n' (portable fallback)
+static inline unsigned int DelimiterMask(const char* p)
+{
+    unsigned int mask = 0;
+    for(int i = 0; i < CSV_SCAN_BLOCK; i++)
+    {
+        if(p[i] == ',' || p[i] == '\n')
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+#endif
+
+// Scan a row only until its first wantedCommas commas are found
+const char* ScanCsvFields(const char* p, const char* end, int* commas, int wantedCommas, int& commaCount)
+{
+    const char* row = p;
+    commaCount = 0;
+    if(wantedCommas <= 0)
+    {
+        return p;
+    }
+
+    // Whole blocks: stop at the newline or at the last wanted comma
+    while(end - p >= CSV_SCAN_BLOCK)
+    {
+        unsigned int mask = DelimiterMask(p);
+        while(mask != 0)
+        {
+            const char* hit = p + LowestBit(mask);
+            if(*hit == '\n')
+            {
+                return hit;
+            }
+            commas[commaCount++] = static_cast<int>(hit - row);
+            if(commaCount == wantedCommas)
+            {
+                return hit;
+            }
+            mask &= mask - 1;
+        }
+        p += CSV_SCAN_BLOCK;
+    }
+
+    // Tail shorter than a block
+    for(; p < end; ++p)
+    {
+        if(*p == '\n')
+        {
+            return p;
+        }
+        if(*p == ',')
+        {
+            commas[commaCount++] = static_cast<int>(p - row);
+            if(commaCount == wantedCommas)
+            {
+                return p;
+            }
+        }
+    }
+    return end;
+}
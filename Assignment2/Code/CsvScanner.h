@@ -0,0 +1,40 @@
+#ifndef CSVSCANNER_H_INCLUDED
+#define CSVSCANNER_H_INCLUDED
+
+/**
+ * @file CsvScanner.h
+ * @brief Vectorized search for the structural characters of a CSV row.
+ *
+ * A row is scanned in 32-byte blocks: every byte of the block is compared
+ * against ',' and '\n' at once and the matches are collected into a
+ * bit mask, so only the delimiters themselves are visited one at a time.
+ *
+ * The block compare uses AVX2 when the compiler targets it (-mavx2 or
+ * -march=native), SSE2 on any other x86-64 build, and a plain byte loop
+ * elsewhere. The tail of the buffer that does not fill a whole block is
+ * always scanned byte by byte, so the scanner never reads past @p end.
+ */
+
+/**
+ * @brief Block size, in bytes, examined per vector compare step.
+ */
+const int CSV_SCAN_BLOCK = 32;
+
+/**
+ * @brief Finds the offsets of the first @p wantedCommas commas of a row.
+ *
+ * The scan stops as soon as the last wanted comma is found, so the fields
+ * after it are never examined. Callers that need the row end afterwards
+ * can search for the newline with memchr().
+ *
+ * @param p            First character of the row.
+ * @param end          End of the buffer.
+ * @param commas       Receives the comma offsets, relative to @p p.
+ * @param wantedCommas Number of commas to find (capacity of @p commas).
+ * @param commaCount   Receives the number of commas found.
+ * @return Pointer to the last wanted comma if all were found; otherwise
+ *         the '\n' that ends the row, or @p end if there is none.
+ */
+const char* ScanCsvFields(const char* p, const char* end, int* commas, int wantedCommas, int& commaCount);
+
+#endif // CSVSCANNER_H_INCLUDED
@@ -0,0 +1,163 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include "CsvScanner.h"
+using namespace std;
+
+// Small wrapper to display [OK] / [FAIL] for each test condition
+void Assert(bool condition, const string& message)
+{
+    if (!condition)
+    {
+        cout << "[FAIL] " << message << endl;
+    }
+    else
+    {
+        cout << "[OK] " << message << endl;
+    }
+}
+
+// Reference scan: byte by byte, collecting up to wanted commas before the first newline.
+// Returns the offset ScanCsvFields should stop at.
+size_t NaiveScan(const string& s, int wanted, vector<int>& commas)
+{
+    commas.clear();
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        if (s[i] == '\n')
+        {
+            return i;
+        }
+        if (s[i] == ',')
+        {
+            commas.push_back(static_cast<int>(i));
+            if (static_cast<int>(commas.size()) == wanted)
+            {
+                return i;
+            }
+        }
+    }
+    return s.size();
+}
+
+// Runs ScanCsvFields over s and compares it with NaiveScan
+bool ScanMatches(const string& s, int wanted)
+{
+    vector<int> expected;
+    size_t expectedStop = NaiveScan(s, wanted, expected);
+
+    // One guard slot past the wanted commas must stay untouched
+    vector<int> commas(wanted + 1, -1);
+    int count = 0;
+    const char* stop = ScanCsvFields(s.data(), s.data() + s.size(), &commas[0], wanted, count);
+
+    if (static_cast<size_t>(stop - s.data()) != expectedStop || count != static_cast<int>(expected.size()) ||
+        commas[wanted] != -1)
+    {
+        return false;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (commas[i] != expected[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Verifies a typical MetData row
+void TestTypicalRow()
+{
+    cout << "\n=== TestTypicalRow ===\n";
+    string row = "31/3/2016 9:00,14.6,175,17,0,1013.4,1016.9,1017,0,68.2,6,512,22.7,24.1,25.5,26.1,8,20.74\nnext";
+
+    vector<int> commas(32);
+    int count = 0;
+    const char* end = ScanCsvFields(row.data(), row.data() + row.size(), &commas[0], 32, count);
+
+    Assert(count == 17, "18 fields give 17 commas");
+    Assert(commas[0] == 14, "First comma follows the WAST field");
+    Assert(*end == '\n' && string(end + 1) == "next", "Scan stops at the newline");
+}
+
+// Verifies rows that end without a newline, empty rows and blank fields
+void TestEdgeRows()
+{
+    cout << "\n=== TestEdgeRows ===\n";
+    Assert(ScanMatches("", 4), "Empty buffer");
+    Assert(ScanMatches("\n", 4), "Empty row");
+    Assert(ScanMatches("a,b,c", 4), "Row without trailing newline");
+    Assert(ScanMatches(",,,,\n", 8), "Row of empty fields");
+    Assert(ScanMatches(string(31, 'x') + ",\n", 4), "Comma on the last byte of a block");
+    Assert(ScanMatches(string(32, 'x') + ",\n", 4), "Comma on the first byte of the next block");
+    Assert(ScanMatches(string(100, ','), 200), "Long row of commas");
+}
+
+// Verifies that no offsets are written past the wanted commas
+void TestCommaLimit()
+{
+    cout << "\n=== TestCommaLimit ===\n";
+    string row = string(70, ',') + "\n";
+
+    vector<int> commas(5, -1);
+    int count = 0;
+    const char* stop = ScanCsvFields(row.data(), row.data() + row.size(), &commas[0], 4, count);
+
+    Assert(count == 4 && stop == row.data() + 3, "Scan stops at the fourth comma");
+    Assert(commas[3] == 3 && commas[4] == -1, "No offsets written past the wanted commas");
+}
+
+// Verifies that ScanCsvFields stops at the last wanted comma
+void TestFieldScan()
+{
+    cout << "\n=== TestFieldScan ===\n";
+    string row = "31/3/2016 9:00,14.6,175,17,0,1013.4,1016.9,1017,0,68.2,6,512,22.7,24.1,25.5,26.1,8,20.74\n";
+
+    vector<int> commas(12);
+    int count = 0;
+    const char* stop = ScanCsvFields(row.data(), row.data() + row.size(), &commas[0], 12, count);
+    Assert(count == 12 && *stop == ',' && stop - row.data() == commas[11], "Stops at the 12th comma");
+
+    string shortRow = "a,b\nc,d,e";
+    stop = ScanCsvFields(shortRow.data(), shortRow.data() + shortRow.size(), &commas[0], 3, count);
+    Assert(count == 1 && *stop == '\n', "Short row stops at its newline");
+
+    string longRow = string(40, 'x') + "," + string(40, 'y') + ",z";
+    stop = ScanCsvFields(longRow.data(), longRow.data() + longRow.size(), &commas[0], 2, count);
+    Assert(count == 2 && commas[0] == 40 && commas[1] == 81, "Commas found across blocks");
+}
+
+// Compares the scanner with the reference scan on random input
+void TestRandomRows()
+{
+    cout << "\n=== TestRandomRows ===\n";
+    const char alphabet[] = "0123456789.,,\n-ab";
+    srand(283);
+
+    bool allMatch = true;
+    for (int trial = 0; trial < 2000 && allMatch; trial++)
+    {
+        string s;
+        int length = rand() % 200;
+        for (int i = 0; i < length; i++)
+        {
+            s += alphabet[rand() % (sizeof(alphabet) - 1)];
+        }
+        allMatch = ScanMatches(s, 1 + rand() % 40);
+    }
+    Assert(allMatch, "Scanner matches byte-by-byte scan on 2000 random rows");
+}
+
+int main()
+{
+    TestTypicalRow();
+    TestEdgeRows();
+    TestCommaLimit();
+    TestFieldScan();
+    TestRandomRows();
+
+    cout << "\n=== ALL TESTS COMPLETE ===\n";
+    return 0;
+}
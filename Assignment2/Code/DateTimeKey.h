@@ -4,6 +4,29 @@
 #include "Date.h"
 #include "Time.h"
 
+/**
+ * @brief Packs a timestamp into a single integer with chronological ordering.
+ *
+ * Layout, from the most significant bit down:
+ *
+ *     year (44 bits) | month (4) | day (5) | hour (5) | minute (6)
+ *
+ * Each field sits above all finer-grained ones, so comparing two packed
+ * values as integers gives the same order as DateTimeKey::operator<.
+ * Fields must already be in range (month 1-12, day 1-31, hour 0-23,
+ * minute 0-59, year > 0).
+ *
+ * @return The packed timestamp.
+ */
+inline unsigned long long PackDateTime(int year, int month, int day, int hour, int minute)
+{
+    return (static_cast<unsigned long long>(year) << 20) |
+           (static_cast<unsigned long long>(month) << 16) |
+           (static_cast<unsigned long long>(day) << 11) |
+           (static_cast<unsigned long long>(hour) << 6) |
+           static_cast<unsigned long long>(minute);
+}
+
 /**
  * @struct DateTimeKey
  * @brief A sortable key combining Date and Time for BST indexing.
@@ -20,23 +43,21 @@
  *
  * This provides a unique chronological ordering for every WeatherRec entry,
  * ensuring deterministic placement inside the binary search tree.
+ *
+ * The key is stored packed by PackDateTime(), so ordering and equality
+ * are a single integer comparison. The individual fields are unpacked
+ * only when they are asked for, e.g. to display a record.
  */
 struct DateTimeKey
 {
 public:
-    int year;    ///< Year component
-    int month;   ///< Month component (112)
-    int day;     ///< Day component (131)
-    int hour;    ///< Hour component (023)
-    int minute;  ///< Minute component (059)
-
     /**
      * @brief Default constructor.
      *
-     * Initializes all fields to zero. Primarily used for placeholder keys.
+     * Initializes the key to zero. Primarily used for placeholder keys.
      */
     DateTimeKey()
-        : year(0), month(0), day(0), hour(0), minute(0)
+        : m_packed(0)
     {
     }
 
@@ -46,12 +67,71 @@ public:
      * @param t Time component.
      */
     DateTimeKey(const Date& d, const Time& t)
-        : year(d.GetYear()),
-          month(d.GetMonth()),
-          day(d.GetDay()),
-          hour(t.GetHours()),
-          minute(t.GetMinutes())
+        : m_packed(PackDateTime(d.GetYear(), d.GetMonth(), d.GetDay(), t.GetHours(), t.GetMinutes()))
+    {
+    }
+
+    /**
+     * @brief Constructs a key from a timestamp packed by PackDateTime().
+     * @param packed Packed timestamp.
+     */
+    explicit DateTimeKey(unsigned long long packed)
+        : m_packed(packed)
+    {
+    }
+
+    /**
+     * @brief Returns this key packed by PackDateTime().
+     */
+    unsigned long long GetPacked() const
+    {
+        return m_packed;
+    }
+
+    /** @brief Returns the year component. */
+    int GetYear() const
     {
+        return static_cast<int>(m_packed >> 20);
+    }
+
+    /** @brief Returns the month component (112). */
+    int GetMonth() const
+    {
+        return static_cast<int>((m_packed >> 16) & 0xF);
+    }
+
+    /** @brief Returns the day component (131). */
+    int GetDay() const
+    {
+        return static_cast<int>((m_packed >> 11) & 0x1F);
+    }
+
+    /** @brief Returns the hour component (023). */
+    int GetHour() const
+    {
+        return static_cast<int>((m_packed >> 6) & 0x1F);
+    }
+
+    /** @brief Returns the minute component (059). */
+    int GetMinute() const
+    {
+        return static_cast<int>(m_packed & 0x3F);
+    }
+
+    /**
+     * @brief Returns the date part of the key.
+     */
+    Date GetDate() const
+    {
+        return Date(GetDay(), GetMonth(), GetYear());
+    }
+
+    /**
+     * @brief Returns the time part of the key.
+     */
+    Time GetTime() const
+    {
+        return Time(GetHour(), GetMinute());
     }
 
     /**
@@ -64,23 +144,7 @@ public:
      */
     bool operator<(const DateTimeKey& other) const
     {
-        if (year != other.year)
-        {
-            return year < other.year;
-        }
-        if (month != other.month)
-        {
-            return month < other.month;
-        }
-        if (day != other.day)
-        {
-            return day < other.day;
-        }
-        if (hour != other.hour)
-        {
-            return hour < other.hour;
-        }
-        return minute < other.minute;
+        return m_packed < other.m_packed;
     }
 
     /**
@@ -100,12 +164,11 @@ public:
      */
     bool operator==(const DateTimeKey& other) const
     {
-        return year   == other.year &&
-               month  == other.month &&
-               day    == other.day &&
-               hour   == other.hour &&
-               minute == other.minute;
+        return m_packed == other.m_packed;
     }
+
+private:
+    unsigned long long m_packed; ///< Timestamp packed by PackDateTime()
 };
 
 #endif // DATETIMEKEY_H_INCLUDED
@@ -74,12 +74,37 @@ void TestOrdering()
     cout << "Minute ordering OK\n";
 }
 
+// Test that the packed key round-trips every field
+// and orders the same way as its packed integer.
+void TestPacked()
+{
+    DateTimeKey key(Date(31, 12, 2024), Time(23, 59));
+
+    assert(key.GetYear() == 2024);
+    assert(key.GetMonth() == 12);
+    assert(key.GetDay() == 31);
+    assert(key.GetHour() == 23);
+    assert(key.GetMinute() == 59);
+    assert(key.GetDate().GetDay() == 31 && key.GetTime().GetMinutes() == 59);
+
+    // Same key whether built from Date/Time or from PackDateTime()
+    assert(key == DateTimeKey(PackDateTime(2024, 12, 31, 23, 59)));
+
+    // The last minute of a year sorts before the first minute of the next
+    DateTimeKey next(Date(1, 1, 2025), Time(0, 0));
+    assert(key < next);
+    assert(key.GetPacked() < next.GetPacked());
+
+    cout << "Packed key OK\n";
+}
+
 // Program entry point for running tests
 int main()
 {
     // Run all test groups
     TestEquality();
     TestOrdering();
+    TestPacked();
 
     cout << "All DateTimeKey tests passed.\n";
     return 0;
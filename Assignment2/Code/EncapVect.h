@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 using std::out_of_range;
@@ -34,6 +35,32 @@ public:
      */
     Vector(int n);
 
+    /**
+     * @brief Copy constructor. Copies every element of another Vector.
+     * @param other Vector to copy from.
+     */
+    Vector(const Vector& other);
+
+    /**
+     * @brief Move constructor. Takes the storage of another Vector.
+     * @param other Vector to move from; left empty.
+     */
+    Vector(Vector&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other Vector to copy from.
+     * @return Reference to this vector.
+     */
+    Vector& operator=(const Vector& other);
+
+    /**
+     * @brief Move assignment operator. Takes the storage of another Vector.
+     * @param other Vector to move from; left empty.
+     * @return Reference to this vector.
+     */
+    Vector& operator=(Vector&& other) noexcept;
+
     /**
      * @brief Appends a new value to the end of the vector.
      * @param value Element to append.
@@ -85,6 +112,20 @@ public:
      */
     void PushBack(const T& value);
 
+    /**
+     * @brief Appends an element to the end of the vector by moving it.
+     * @param value Element to move in.
+     */
+    void PushBack(T&& value);
+
+    /**
+     * @brief Constructs an element in place at the end of the vector.
+     * @param args Arguments forwarded to the constructor of T.
+     * @return Reference to the new element.
+     */
+    template <class... Args>
+    T& EmplaceBack(Args&&... args);
+
     /**
      * @brief Provides indexed access to elements with bounds checking.
      * @param index Index of the requested element.
@@ -101,6 +142,61 @@ public:
      */
     const T& operator[](int index) const;
 
+    /**
+     * @brief Indexed access that is bounds-checked only in debug builds.
+     *
+     * With NDEBUG defined this is a plain array access, for loops whose
+     * bounds are already known to be valid.
+     *
+     * @param index Index of the requested element.
+     * @return Reference to the element at the specified index.
+     * @throws out_of_range If index is invalid and NDEBUG is not defined.
+     */
+    T& GetUnchecked(int index);
+
+    /**
+     * @brief Const access that is bounds-checked only in debug builds.
+     * @param index Index of the requested element.
+     * @return Const reference to the element at the specified index.
+     * @throws out_of_range If index is invalid and NDEBUG is not defined.
+     */
+    const T& GetUnchecked(int index) const;
+
+    /**
+     * @brief Pointer to the contiguous elements, for bulk and SIMD loops.
+     * @return Pointer to the first element; may be null when empty.
+     */
+    T* Data();
+
+    /**
+     * @brief Const pointer to the contiguous elements.
+     * @return Pointer to the first element; may be null when empty.
+     */
+    const T* Data() const;
+
+    typedef T* Iterator;             ///< Element iterator (a plain pointer).
+    typedef const T* ConstIterator;  ///< Const element iterator.
+
+    /**
+     * @brief Iterator to the first element, so the vector works in range-for loops.
+     */
+    Iterator begin();
+
+    /**
+     * @brief Iterator one past the last element.
+     */
+    Iterator end();
+
+    /**
+     * @brief Const iterator to the first element.
+     */
+    ConstIterator begin() const;
+
+    /**
+     * @brief Const iterator one past the last element.
+     */
+    ConstIterator end() const;
+
 private:
     vector<T> m_data; ///< Underlying storage container.
 };
@@ -120,6 +216,35 @@ Vector<T>::Vector(int n) : m_data()
     }
 }
 
+template <class T>
+Vector<T>::Vector(const Vector& other) : m_data(other.m_data)
+{
+}
+
+template <class T>
+Vector<T>::Vector(Vector&& other) noexcept : m_data(std::move(other.m_data))
+{
+    other.m_data.clear();
+}
+
+template <class T>
+Vector<T>& Vector<T>::operator=(const Vector& other)
+{
+    m_data = other.m_data;
+    return *this;
+}
+
+template <class T>
+Vector<T>& Vector<T>::operator=(Vector&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_data = std::move(other.m_data);
+        other.m_data.clear();
+    }
+    return *this;
+}
+
 template <class T>
 bool Vector<T>::Add(const T& value)
 {
@@ -140,6 +265,20 @@ void Vector<T>::PushBack(const T& value)
     m_data.push_back(value);
 }
 
+template <class T>
+void Vector<T>::PushBack(T&& value)
+{
+    m_data.push_back(std::move(value));
+}
+
+template <class T>
+template <class... Args>
+T& Vector<T>::EmplaceBack(Args&&... args)
+{
+    m_data.emplace_back(std::forward<Args>(args)...);
+    return m_data.back();
+}
+
 template <class T>
 bool Vector<T>::Insert(int index, const T& value)
 {
@@ -191,6 +330,66 @@ const T& Vector<T>::operator[](int index) const
     return m_data[index];
 }
 
+template <class T>
+T& Vector<T>::GetUnchecked(int index)
+{
+#ifndef NDEBUG
+    if (index < 0 || index >= static_cast<int>(m_data.size()))
+    {
+        throw out_of_range("Index out of bounds");
+    }
+#endif
+    return m_data[index];
+}
+
+template <class T>
+const T& Vector<T>::GetUnchecked(int index) const
+{
+#ifndef NDEBUG
+    if (index < 0 || index >= static_cast<int>(m_data.size()))
+    {
+        throw out_of_range("Index out of bounds");
+    }
+#endif
+    return m_data[index];
+}
+
+template <class T>
+T* Vector<T>::Data()
+{
+    return m_data.data();
+}
+
+template <class T>
+const T* Vector<T>::Data() const
+{
+    return m_data.data();
+}
+
+template <class T>
+typename Vector<T>::Iterator Vector<T>::begin()
+{
+    return m_data.data();
+}
+
+template <class T>
+typename Vector<T>::Iterator Vector<T>::end()
+{
+    return m_data.data() + m_data.size();
+}
+
+template <class T>
+typename Vector<T>::ConstIterator Vector<T>::begin() const
+{
+    return m_data.data();
+}
+
+template <class T>
+typename Vector<T>::ConstIterator Vector<T>::end() const
+{
+    return m_data.data() + m_data.size();
+}
+
 template <class T>
 int Vector<T>::GetSize() const
 {
@@ -3,6 +3,8 @@
 
 #include <map>
 #include <stdexcept>
+#include <tuple>
+#include <utility>
 #include "EncapVect.h"
 
 using std::runtime_error;
@@ -28,6 +30,32 @@ public:
      */
     Map();
 
+    /**
+     * @brief Copy constructor. Copies every key and value of another map.
+     * @param other Map to copy from.
+     */
+    Map(const Map& other);
+
+    /**
+     * @brief Move constructor. Takes the nodes of another map without copying them.
+     * @param other Map to move from; left empty.
+     */
+    Map(Map&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator.
+     * @param other Map to copy from.
+     * @return Reference to this map.
+     */
+    Map& operator=(const Map& other);
+
+    /**
+     * @brief Move assignment operator.
+     * @param other Map to move from; left empty.
+     * @return Reference to this map.
+     */
+    Map& operator=(Map&& other) noexcept;
+
     /**
      * @brief Checks whether a given key exists in the map.
      * @param key Key to search for.
@@ -46,6 +74,13 @@ public:
      */
     void Clear();
 
+    /**
+     * @brief Removes the element with the given key, if present.
+     * @param key Key to remove.
+     * @return True if an element was removed.
+     */
+    bool Remove(const K& key);
+
     /**
      * @brief Accesses (or creates) the value associated with a key.
      *
@@ -56,6 +91,20 @@ public:
      */
     V& operator[](const K& key);
 
+    /**
+     * @brief Constructs the value for a key in place, if the key is absent.
+     *
+     * An existing value is left untouched and @p args are not used, so a
+     * caller can pass a temporary container without it being copied or
+     * overwriting what is already stored.
+     *
+     * @param key Key to look up or insert.
+     * @param args Arguments forwarded to the constructor of V.
+     * @return Reference to the value now stored for the key.
+     */
+    template <class... Args>
+    V& TryEmplace(const K& key, Args&&... args);
+
     /**
      * @brief Retrieves the value for a key without inserting defaults.
      *
@@ -85,6 +134,35 @@ Map<K, V>::Map()
 {
 }
 
+template <class K, class V>
+Map<K, V>::Map(const Map& other) : m_data(other.m_data)
+{
+}
+
+template <class K, class V>
+Map<K, V>::Map(Map&& other) noexcept : m_data(std::move(other.m_data))
+{
+    other.m_data.clear();
+}
+
+template <class K, class V>
+Map<K, V>& Map<K, V>::operator=(const Map& other)
+{
+    m_data = other.m_data;
+    return *this;
+}
+
+template <class K, class V>
+Map<K, V>& Map<K, V>::operator=(Map&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_data = std::move(other.m_data);
+        other.m_data.clear();
+    }
+    return *this;
+}
+
 template <class K, class V>
 bool Map<K, V>::Contains(const K& key) const
 {
@@ -103,12 +181,31 @@ void Map<K, V>::Clear()
     m_data.clear();
 }
 
+template <class K, class V>
+bool Map<K, V>::Remove(const K& key)
+{
+    return m_data.erase(key) > 0;
+}
+
 template <class K, class V>
 V& Map<K, V>::operator[](const K& key)
 {
     return m_data[key]; // creates default value if missing
 }
 
+template <class K, class V>
+template <class... Args>
+V& Map<K, V>::TryEmplace(const K& key, Args&&... args)
+{
+    typename map<K, V>::iterator it = m_data.lower_bound(key);
+    if (it == m_data.end() || m_data.key_comp()(key, it->first))
+    {
+        it = m_data.emplace_hint(it, std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+    return it->second;
+}
+
 template <class K, class V>
 const V& Map<K, V>::At(const K& key) const
 {
@@ -67,7 +67,32 @@ int main()
     }
 
 
-    cout << "\n=== TEST 5: Clear() ===\n";
+    cout << "\n=== TEST 5: Remove() ===\n";
+    wordCount["extra"] = 1;
+    cout << "Remove(\"extra\") = " << (wordCount.Remove("extra") ? "true" : "false")
+         << ", again = " << (wordCount.Remove("extra") ? "true" : "false") << endl;
+    cout << "Contains(\"extra\")? "
+         << (wordCount.Contains("extra") ? "Yes" : "No") << endl;
+
+
+    cout << "\n=== TEST 6: TryEmplace() ===\n";
+    Map<int, Vector<string> > groups;
+    groups.TryEmplace(1).PushBack("one");
+    groups.TryEmplace(1, 5).PushBack("ignored arguments");
+    cout << "Size of group 1 (Expected 2): " << groups.At(1).GetSize() << endl;
+    cout << "Size of new group 2 (Expected 3): " << groups.TryEmplace(2, 3).GetSize() << endl;
+
+
+    cout << "\n=== TEST 7: Move ===\n";
+    Map<int, Vector<string> > moved(std::move(groups));
+    cout << "Moved size (Expected 2): " << moved.Size()
+         << ", source size (Expected 0): " << groups.Size() << endl;
+    groups = std::move(moved);
+    cout << "Assigned back (Expected 2): " << groups.Size()
+         << ", moved-from (Expected 0): " << moved.Size() << endl;
+
+
+    cout << "\n=== TEST 8: Clear() ===\n";
     wordCount.Clear();
 
     cout << "Size after Clear(): " << wordCount.Size() << endl;
@@ -0,0 +1,181 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Default constructor: nothing mapped yet
+MappedFile::MappedFile()
+{
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+#ifdef _WIN32
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = nullptr;
+#else
+    m_fd = -1;
+#endif
+}
+
+// Destructor: release the mapping
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+// Map the whole file read-only using the Win32 API
+bool MappedFile::Open(const string& path)
+{
+    Close();
+
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                         nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(m_file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(m_file, &size))
+    {
+        Close();
+        return false;
+    }
+
+    m_size = size.QuadPart;
+    m_open = true;
+
+    // Zero-length files cannot be mapped, but are valid (empty) input
+    if(m_size == 0)
+    {
+        return true;
+    }
+
+    m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(m_mapping == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if(m_data == nullptr)
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+// Unmap the view and close both handles
+void MappedFile::Close()
+{
+    if(m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+    }
+    if(m_mapping != nullptr)
+    {
+        CloseHandle(m_mapping);
+    }
+    if(m_file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_file);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = nullptr;
+}
+
+#else
+
+// Map the whole file read-only using mmap
+bool MappedFile::Open(const string& path)
+{
+    Close();
+
+    m_fd = open(path.c_str(), O_RDONLY);
+    if(m_fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if(fstat(m_fd, &info) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_size = info.st_size;
+    m_open = true;
+
+    // Zero-length files cannot be mapped, but are valid (empty) input
+    if(m_size == 0)
+    {
+        return true;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if(view == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+
+    // Rows are consumed front to back exactly once
+    madvise(view, static_cast<size_t>(m_size), MADV_SEQUENTIAL);
+
+    m_data = static_cast<const char*>(view);
+    return true;
+}
+
+// Unmap the view and close the descriptor
+void MappedFile::Close()
+{
+    if(m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), static_cast<size_t>(m_size));
+    }
+    if(m_fd >= 0)
+    {
+        close(m_fd);
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+    m_fd = -1;
+}
+
+#endif
+
+// Returns true while a file is mapped
+bool MappedFile::IsOpen() const
+{
+    return m_open;
+}
+
+// Returns the start of the mapped buffer
+const char* MappedFile::GetData() const
+{
+    return m_data;
+}
+
+// Returns the number of mapped bytes
+long long MappedFile::GetSize() const
+{
+    return m_size;
+}
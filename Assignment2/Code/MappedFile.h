@@ -0,0 +1,85 @@
+#ifndef MAPPEDFILE_H_INCLUDED
+#define MAPPEDFILE_H_INCLUDED
+
+#include <string>
+
+using std::string;
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The file contents are exposed as a single contiguous character buffer,
+ * so callers can tokenize rows in place without copying them into
+ * strings or streams. The mapping is released when the object is closed
+ * or destroyed.
+ *
+ * On Windows the mapping is created with CreateFileMapping/MapViewOfFile,
+ * everywhere else with POSIX mmap.
+ *
+ * The buffer is **not** null-terminated; always use GetSize().
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Constructs an unopened mapping.
+     */
+    MappedFile();
+
+    /**
+     * @brief Destructor. Unmaps the file if it is still open.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Maps the given file into memory.
+     *
+     * Any previously mapped file is closed first. An empty file opens
+     * successfully with a size of zero and a null data pointer.
+     *
+     * @param path Path of the file to map.
+     * @return True if the file was opened and mapped, false otherwise.
+     */
+    bool Open(const string& path);
+
+    /**
+     * @brief Unmaps the file and releases all handles.
+     */
+    void Close();
+
+    /**
+     * @brief Checks whether a file is currently mapped.
+     * @return True if Open() succeeded and Close() has not been called.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Returns the first byte of the mapped buffer.
+     * @return Pointer to the file contents, or nullptr if empty/unopened.
+     */
+    const char* GetData() const;
+
+    /**
+     * @brief Returns the size of the mapped buffer in bytes.
+     */
+    long long GetSize() const;
+
+private:
+    const char* m_data;  ///< Start of the mapped view.
+    long long m_size;    ///< Number of mapped bytes.
+    bool m_open;         ///< True while a file is mapped.
+
+#ifdef _WIN32
+    void* m_file;        ///< Win32 file handle.
+    void* m_mapping;     ///< Win32 file-mapping handle.
+#else
+    int m_fd;            ///< POSIX file descriptor.
+#endif
+
+    // Mappings own OS handles and must not be copied.
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+#endif // MAPPEDFILE_H_INCLUDED
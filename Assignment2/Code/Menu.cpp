@@ -1,16 +1,19 @@
 #include <iostream>
+#include <stdexcept>
 #include "Menu.h"
 
 using std::cin;
 using std::cout;
 using std::endl;
 using std::string;
+using std::invalid_argument;
 
 // Main menu
 void Menu::Run()
 {
-    // Load weather data from CSV files before starting menu
-    if (!log.LoadData())
+    // Load weather data from CSV files before starting menu, following
+    // them so rows appended while the menu runs are picked up
+    if (!log.LoadData(LOAD_MAPPED, 0, true))
     {
         cout << "Failed to load weather data. Exiting.\n";
         return;
@@ -21,12 +24,18 @@ void Menu::Run()
     // Main menu loop, continues until user chooses to exit
     do
     {
+        // Pick up rows appended to the data files since the last choice
+        log.PollAppendedData();
+
         // Display menu options to the user
         cout << "\n Weather Data Menu \n";
         cout << "1. Display average wind speed and SD for a month/year\n";
         cout << "2. Display average ambient air temperature and SD for each month of a year\n";
         cout << "3. Display sample Pearson Correlation Coefficient (sPCC) for a month\n";
         cout << "4. Display average wind speed(km/h), average ambient air temperature and total solar radiation in kWh/m2 for each month of a specified year\n";
+        cout << "5. Display average and SD of another sensor (DP, RH, QFE, Sx, ST1-ST4, ...) for a month/year\n";
+        cout << "6. Display wind speed, ambient air temperature and solar radiation between two dates and times\n";
+        cout << "7. Display median and 95th percentile of wind speed, ambient air temperature and solar radiation for a month/year\n";
         cout << "0. Exit\n";
         cout << "Enter your choice: ";
         cin >> choice;
@@ -72,6 +81,55 @@ void Menu::Run()
             log.DisplaySpeedTempSolarRadWithMAD(year);  // Call WeatherLog method
             break;
         }
+        case 5:
+        {
+            // Option 5: Average and SD of a sensor column that is read on first use
+            string code;
+            int month, year;
+            cout << "Enter sensor code (e.g. DP, RH, QFE, Sx, ST1): ";
+            cin >> code;
+            cout << "Enter month (1-12): ";
+            cin >> month;
+            cout << "Enter year: ";
+            cin >> year;
+            log.DisplaySensorAvg(code, month, year);  // Call WeatherLog method
+            break;
+        }
+        case 6:
+        {
+            // Option 6: Statistics for an arbitrary time window, e.g. 3 Mar 14:00 to 9 Mar 06:00
+            Date fromDate, toDate;
+            Time fromTime, toTime;
+            try
+            {
+                cout << "Enter start date (day month year): ";
+                cin >> fromDate;
+                cout << "Enter start time (HH:MM): ";
+                cin >> fromTime;
+                cout << "Enter end date (day month year): ";
+                cin >> toDate;
+                cout << "Enter end time (HH:MM): ";
+                cin >> toTime;
+            }
+            catch (const invalid_argument& e)
+            {
+                cout << "Invalid date: " << e.what() << endl;
+                break;
+            }
+            log.DisplayRange(DateTimeKey(fromDate, fromTime), DateTimeKey(toDate, toTime));  // Call WeatherLog method
+            break;
+        }
+        case 7:
+        {
+            // Option 7: Median and 95th percentile of each reading for a given month and year
+            int month, year;
+            cout << "Enter month (1-12): ";
+            cin >> month;
+            cout << "Enter year: ";
+            cin >> year;
+            log.DisplayPercentiles(month, year);  // Call WeatherLog method
+            break;
+        }
         case 0:
             // Exit the program
             cout << "Exiting program. Goodbye!\n";
@@ -0,0 +1,25 @@
+#include "MonthColumns.h"
+
+// Number of rows
+int MonthColumns::GetSize() const
+{
+    return keys.GetSize();
+}
+
+// Remove every row
+void MonthColumns::Clear()
+{
+    keys.Clear();
+    speed.Clear();
+    temp.Clear();
+    solar.Clear();
+}
+
+// Append a row at the end of every column
+void MonthColumns::PushBack(const RecNode& node)
+{
+    keys.PushBack(node.GetKey().GetPacked());
+    speed.PushBack(node.rec.GetSpeed());
+    temp.PushBack(node.rec.GetAmbAirTemp());
+    solar.PushBack(node.rec.GetSolarRad());
+}
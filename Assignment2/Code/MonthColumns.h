@@ -0,0 +1,45 @@
+#ifndef MONTHCOLUMNS_H_INCLUDED
+#define MONTHCOLUMNS_H_INCLUDED
+
+#include "EncapVect.h"
+#include "RecNode.h"
+
+/**
+ * @class MonthColumns
+ * @brief The records of one month stored as parallel, contiguous columns.
+ *
+ * Row i of the month is keys[i], speed[i], temp[i] and solar[i]. Rows are
+ * kept sorted by timestamp with no two rows sharing a timestamp, which is
+ * the order an in-order traversal of the month's BST produces, so the
+ * statistics can scan the float columns from start to end.
+ *
+ * Compared with one Bst node per record (a DateTimeKey, a WeatherRec and
+ * two child pointers, each node a separate allocation), a row takes 20
+ * bytes: an 8-byte packed timestamp and three floats.
+ */
+class MonthColumns
+{
+public:
+    Vector<unsigned long long> keys; ///< Timestamps packed by PackDateTime(), ascending.
+    Vector<float> speed;             ///< Wind speed (km/h).
+    Vector<float> temp;              ///< Ambient air temperature.
+    Vector<float> solar;             ///< Solar radiation.
+
+    /**
+     * @brief Number of rows.
+     */
+    int GetSize() const;
+
+    /**
+     * @brief Removes every row.
+     */
+    void Clear();
+
+    /**
+     * @brief Appends a row; its key must be greater than the last key.
+     * @param node Record to append.
+     */
+    void PushBack(const RecNode& node);
+};
+
+#endif // MONTHCOLUMNS_H_INCLUDED
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <string>
+#include "MonthColumns.h"
+using namespace std;
+
+// Small wrapper to display [OK] / [FAIL] for each test condition
+void Assert(bool condition, const string& message)
+{
+    if (!condition)
+    {
+        cout << "[FAIL] " << message << endl;
+    }
+    else
+    {
+        cout << "[OK] " << message << endl;
+    }
+}
+
+// Builds a record on 1/3/2016 at the given hour, tagged by its speed
+RecNode MakeNode(int hour, float speed)
+{
+    return RecNode(PackDateTime(2016, 3, 1, hour, 0), speed, 100.0f, 20.0f);
+}
+
+// True if the keys are strictly increasing
+bool KeysAscending(const MonthColumns& columns)
+{
+    for (int i = 1; i < columns.GetSize(); i++)
+    {
+        if (columns.keys[i - 1] >= columns.keys[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Verifies that appended rows keep every column aligned
+void TestPushBack()
+{
+    cout << "\n=== TestPushBack ===\n";
+    MonthColumns columns;
+    columns.PushBack(MakeNode(3, 3.0f));
+    columns.PushBack(MakeNode(6, 6.0f));
+    columns.PushBack(MakeNode(9, 9.0f));
+
+    Assert(columns.GetSize() == 3 && KeysAscending(columns), "Three rows in order");
+    Assert(columns.keys[1] == PackDateTime(2016, 3, 1, 6, 0), "Key packed from the record");
+    Assert(columns.speed[0] == 3.0f && columns.speed[1] == 6.0f && columns.speed[2] == 9.0f,
+           "Speeds follow their keys");
+    Assert(columns.temp[2] == 20.0f && columns.solar[2] == 100.0f, "Temperature and solar in their own columns");
+    Assert(columns.temp.GetSize() == 3 && columns.solar.GetSize() == 3, "Columns the same length");
+}
+
+// Verifies that Clear empties every column and the month can be refilled
+void TestClear()
+{
+    cout << "\n=== TestClear ===\n";
+    MonthColumns columns;
+    columns.PushBack(MakeNode(4, 4.0f));
+    columns.PushBack(MakeNode(7, 7.0f));
+
+    columns.Clear();
+    Assert(columns.GetSize() == 0 && columns.speed.GetSize() == 0, "Clear empties every column");
+    Assert(columns.temp.GetSize() == 0 && columns.solar.GetSize() == 0, "Clear empties the reading columns");
+
+    columns.PushBack(MakeNode(1, 1.0f));
+    Assert(columns.GetSize() == 1 && columns.speed[0] == 1.0f, "Refilled after Clear");
+}
+
+int main()
+{
+    TestPushBack();
+    TestClear();
+
+    cout << "\n=== ALL TESTS COMPLETE ===\n";
+    return 0;
+}
@@ -0,0 +1,102 @@
+#ifndef PARALLEL_H_INCLUDED
+#define PARALLEL_H_INCLUDED
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Resolves a requested worker count into an actual thread count.
+ *
+ * @param requested Desired number of threads; 0 or less means one per hardware thread.
+ * @return A thread count of at least 1.
+ */
+inline int ResolveThreadCount(int requested)
+{
+    if (requested > 0)
+    {
+        return requested;
+    }
+
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return (hardware > 0) ? static_cast<int>(hardware) : 1;
+}
+
+/**
+ * @brief Runs func(i) for every i in [0, count) on a small pool of threads.
+ *
+ * Indices are handed out dynamically, so uneven work items (e.g. files of
+ * very different sizes) still keep every thread busy. The calling thread
+ * takes part in the work. Each index is processed exactly once, but in no
+ * particular order, so @p func must only write to state owned by index i.
+ *
+ * If any call throws, the remaining indices are still drained and the
+ * first exception is rethrown on the calling thread after all workers
+ * have joined.
+ *
+ * @param count   Number of work items.
+ * @param threads Maximum number of threads (0 = hardware concurrency, 1 = run serially).
+ * @param func    Callable invoked as func(int index).
+ */
+template <class Func>
+void ParallelFor(int count, int threads, Func func)
+{
+    threads = ResolveThreadCount(threads);
+    if (threads > count)
+    {
+        threads = count;
+    }
+
+    if (threads <= 1)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<int> next(0);
+    std::exception_ptr error;
+    std::mutex errorLock;
+
+    auto worker = [&]()
+    {
+        for (int i = next++; i < count; i = next++)
+        {
+            try
+            {
+                func(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard(errorLock);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+    {
+        pool.push_back(std::thread(worker));
+    }
+    worker();
+
+    for (size_t t = 0; t < pool.size(); t++)
+    {
+        pool[t].join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+#endif // PARALLEL_H_INCLUDED
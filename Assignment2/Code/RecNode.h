@@ -6,16 +6,16 @@
 
 /**
  * @struct RecNode
- * @brief Node wrapper storing a WeatherRec and its sortable DateTimeKey for BST usage.
+ * @brief Node wrapper ordering a WeatherRec by its timestamp for BST usage.
  *
- * RecNode acts as the element type stored in the binary search tree. Each node
- * contains a WeatherRec and an associated DateTimeKey that determines ordering
- * within the BST. Comparison operators use only the DateTimeKey, ensuring that
- * tree operations are based strictly on chronological order.
+ * RecNode acts as the element type stored in the binary search tree. The
+ * record's own packed timestamp (see GetKey()) determines ordering within the
+ * BST; it is not stored a second time, so a node is no larger than its record.
+ * Comparison operators use only the timestamp, ensuring that tree operations
+ * are based strictly on chronological order.
  */
 struct RecNode
 {
-    DateTimeKey key;  /**< Chronological key generated from the record's date and time. */
     WeatherRec rec;   /**< Full weather record stored in this node. */
 
     /**
@@ -29,14 +29,51 @@ struct RecNode
      * @brief Constructs a RecNode from a WeatherRec.
      * @param w The WeatherRec from which to build this node.
      *
-     * Generates a DateTimeKey using the record's date and time, ensuring that
-     * RecNode objects can be placed in the BST in chronological order.
+     * The record's date and time order the node, ensuring that RecNode
+     * objects can be placed in the BST in chronological order.
      */
     RecNode(const WeatherRec &w)
-        : key(w.GetDate(), w.GetTime()), rec(w)
+        : rec(w)
     {
     }
 
+    /**
+     * @brief Constructs a RecNode straight from a packed timestamp and readings.
+     *
+     * Used by the CSV loader, which decodes WAST directly into a packed key.
+     * The timestamp must already be valid (see PackDateTime()).
+     *
+     * @param packedKey  Timestamp packed by PackDateTime().
+     * @param speed      Wind speed.
+     * @param solarRad   Solar radiation.
+     * @param ambAirTemp Ambient air temperature.
+     */
+    RecNode(unsigned long long packedKey, float speed, float solarRad, float ambAirTemp)
+        : rec(DateTimeKey(packedKey), speed, solarRad, ambAirTemp)
+    {
+    }
+
+    /**
+     * @brief Constructs a node holding only a timestamp.
+     *
+     * Used as a bound for range queries; the readings are zero.
+     *
+     * @param when Timestamp of the node.
+     */
+    explicit RecNode(const DateTimeKey& when)
+        : rec(when, 0.0f, 0.0f, 0.0f)
+    {
+    }
+
+    /**
+     * @brief Returns the timestamp that orders this node.
+     * @return The record's DateTimeKey.
+     */
+    DateTimeKey GetKey() const
+    {
+        return rec.GetDateTimeKey();
+    }
+
     /**
      * @brief Comparison operator for BST ordering.
      * @param other Another RecNode to compare against.
@@ -44,7 +81,7 @@ struct RecNode
      */
     bool operator<(const RecNode &other) const
     {
-        return key < other.key;
+        return GetKey() < other.GetKey();
     }
 
     /**
@@ -54,7 +91,7 @@ struct RecNode
      */
     bool operator>(const RecNode &other) const
     {
-        return key > other.key;
+        return GetKey() > other.GetKey();
     }
 
     /**
@@ -64,8 +101,11 @@ struct RecNode
      */
     bool operator==(const RecNode &other) const
     {
-        return key == other.key;
+        return GetKey() == other.GetKey();
     }
 };
 
+// Trees and runs hold millions of nodes; the timestamp lives only in rec
+static_assert(sizeof(RecNode) == sizeof(WeatherRec), "RecNode must not add to WeatherRec");
+
 #endif // RECNODE_H_INCLUDED
@@ -0,0 +1,216 @@
+#include "RecSort.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <vector>
+
+// Radix digits are one byte
+static const int RADIX_BITS = 8;
+static const int RADIX_SIZE = 1 << RADIX_BITS;
+
+// Stable LSD radix sort of records on their packed keys
+void SortByTime(Vector<RecNode>& nodes)
+{
+    int count = nodes.GetSize();
+    if(count < 2)
+    {
+        return;
+    }
+
+    // Find the bits that differ between keys, and whether any are out of order
+    RecNode* data = &nodes[0];
+    unsigned long long first = data[0].GetKey().GetPacked();
+    unsigned long long differing = 0;
+    bool sorted = true;
+    for(int i = 1; i < count; i++)
+    {
+        unsigned long long key = data[i].GetKey().GetPacked();
+        differing |= key ^ first;
+        sorted = sorted && !(data[i] < data[i - 1]);
+    }
+    if(sorted)
+    {
+        return;
+    }
+
+    // Scatter back and forth between the records and a scratch buffer,
+    // one pass per byte that is not the same in every key
+    std::vector<RecNode> scratch(count);
+    RecNode* from = data;
+    RecNode* to = &scratch[0];
+    for(int shift = 0; shift < 64; shift += RADIX_BITS)
+    {
+        if(((differing >> shift) & (RADIX_SIZE - 1)) == 0)
+        {
+            continue;
+        }
+
+        int offsets[RADIX_SIZE] = {0};
+        for(int i = 0; i < count; i++)
+        {
+            offsets[(from[i].GetKey().GetPacked() >> shift) & (RADIX_SIZE - 1)]++;
+        }
+        int total = 0;
+        for(int d = 0; d < RADIX_SIZE; d++)
+        {
+            int size = offsets[d];
+            offsets[d] = total;
+            total += size;
+        }
+        for(int i = 0; i < count; i++)
+        {
+            to[offsets[(from[i].GetKey().GetPacked() >> shift) & (RADIX_SIZE - 1)]++] = from[i];
+        }
+
+        RecNode* done = to;
+        to = from;
+        from = done;
+    }
+
+    // An odd number of passes leaves the result in the scratch buffer
+    if(from != data)
+    {
+        for(int i = 0; i < count; i++)
+        {
+            data[i] = from[i];
+        }
+    }
+}
+
+// Sort each month of the partitions, months spread over the threads
+void SortPartitions(RecPartitions& data, int threads)
+{
+    Vector<Vector<RecNode>*> months;
+    Vector<int> yearKeys;
+    data.GetKeys(yearKeys);
+    for(int y = 0; y < yearKeys.GetSize(); y++)
+    {
+        Map<int, Vector<RecNode>>& year = data[yearKeys[y]];
+        Vector<int> monthKeys;
+        year.GetKeys(monthKeys);
+        for(int m = 0; m < monthKeys.GetSize(); m++)
+        {
+            months.PushBack(&year[monthKeys[m]]);
+        }
+    }
+
+    ParallelFor(months.GetSize(), threads, [&](int i)
+    {
+        SortByTime(*months[i]);
+    });
+}
+
+// The records of one run not merged yet
+struct RunHead
+{
+    const RecNode* next; // first record not merged yet
+    const RecNode* end;  // one past the run's last record
+    int run;             // index of the run in reading order
+
+    RunHead() : next(nullptr), end(nullptr), run(0) {}
+    RunHead(const RecNode* first, const RecNode* last, int index) : next(first), end(last), run(index) {}
+};
+
+// Heap order: the earliest timestamp on top, ties going to the earlier run
+static bool RunHeadAfter(const RunHead& a, const RunHead& b)
+{
+    return *b.next < *a.next || (*b.next == *a.next && a.run > b.run);
+}
+
+// Merge sorted runs, resolving equal timestamps by the policy
+int MergeSortedRuns(const Vector<const Vector<RecNode>*>& runs, DuplicatePolicy policy,
+                    Vector<RecNode>& out, Vector<int>* dropped)
+{
+    int count = runs.GetSize();
+    if(dropped != nullptr)
+    {
+        *dropped = Vector<int>(count);
+    }
+
+    // Only runs with records take part, kept as a binary heap of their heads
+    Vector<RunHead> heads;
+    for(int r = 0; r < count; r++)
+    {
+        const Vector<RecNode>* run = runs[r];
+        if(run != nullptr && !run->IsEmpty())
+        {
+            heads.PushBack(RunHead(run->Data(), run->Data() + run->GetSize(), r));
+        }
+    }
+    RunHead* heap = heads.Data();
+    int heapSize = heads.GetSize();
+    std::make_heap(heap, heap + heapSize, RunHeadAfter);
+
+    out.Clear();
+    int duplicates = 0;
+    while(heapSize > 0)
+    {
+        // Take every record with the earliest timestamp; the heap hands
+        // out the runs holding it in reading order
+        DateTimeKey key = heap[0].next->GetKey();
+        const RecNode* first = nullptr;
+        const RecNode* last = nullptr;
+        int firstRun = 0;
+        int size = 0;
+        double speed = 0.0, solar = 0.0, temp = 0.0;
+        while(heapSize > 0 && heap[0].next->GetKey() == key)
+        {
+            std::pop_heap(heap, heap + heapSize, RunHeadAfter);
+            RunHead& head = heap[heapSize - 1];
+            for(; head.next != head.end && head.next->GetKey() == key; head.next++)
+            {
+                const RecNode& node = *head.next;
+                if(first == nullptr)
+                {
+                    first = &node;
+                    firstRun = head.run;
+                }
+                else
+                {
+                    duplicates++;
+                    if(dropped != nullptr)
+                    {
+                        (*dropped)[head.run]++;
+                    }
+                }
+                last = &node;
+                speed += node.rec.GetSpeed();
+                solar += node.rec.GetSolarRad();
+                temp += node.rec.GetAmbAirTemp();
+                size++;
+            }
+
+            // A run with records left goes back in; an exhausted one stays out
+            if(head.next != head.end)
+            {
+                std::push_heap(heap, heap + heapSize, RunHeadAfter);
+            }
+            else
+            {
+                heapSize--;
+            }
+        }
+
+        if(size == 1 || policy == DUPLICATE_FIRST_WINS)
+        {
+            out.PushBack(*first);
+        }
+        else if(policy == DUPLICATE_LAST_WINS)
+        {
+            out.PushBack(*last);
+        }
+        else if(policy == DUPLICATE_AVERAGE)
+        {
+            out.PushBack(RecNode(key.GetPacked(), static_cast<float>(speed / size),
+                                 static_cast<float>(solar / size), static_cast<float>(temp / size)));
+        }
+        else
+        {
+            duplicates++;
+            if(dropped != nullptr)
+            {
+                (*dropped)[firstRun]++;
+            }
+        }
+    }
+    return duplicates;
+}
@@ -0,0 +1,64 @@
+#ifndef RECSORT_H_INCLUDED
+#define RECSORT_H_INCLUDED
+
+#include "CsvParser.h"
+
+/**
+ * @brief What MergeSortedRuns keeps when several records share a timestamp.
+ */
+enum DuplicatePolicy
+{
+    DUPLICATE_FIRST_WINS, ///< Keep the record read first (the original behaviour).
+    DUPLICATE_LAST_WINS,  ///< Keep the record read last.
+    DUPLICATE_AVERAGE,    ///< Keep one record holding the mean of each reading.
+    DUPLICATE_REJECT      ///< Keep none of them: the timestamp is ambiguous.
+};
+
+/**
+ * @brief Sorts records by timestamp with a stable LSD radix sort.
+ *
+ * Sorts on the packed key (see PackDateTime()), eight bits per pass from
+ * the least significant byte up. Passes over bytes that are the same in
+ * every key are skipped, so one month of records (year and month fixed)
+ * takes at most two passes. Records with equal timestamps keep their
+ * order, so the first one read is still first. Input that is already in
+ * order is detected and left alone.
+ *
+ * @param nodes Records to sort in place.
+ */
+void SortByTime(Vector<RecNode>& nodes);
+
+/**
+ * @brief Sorts every month of a set of partitions by timestamp.
+ *
+ * The months are independent, so they are sorted in parallel.
+ *
+ * @param data    Partitions to sort, one SortByTime() per month.
+ * @param threads Maximum number of threads (0 = hardware concurrency, 1 = serial).
+ */
+void SortPartitions(RecPartitions& data, int threads);
+
+/**
+ * @brief Merges sorted runs of records into one sorted run with unique timestamps.
+ *
+ * Runs are given in reading order: records are "read first" if they come
+ * from an earlier run, or earlier in the same run. The heads of the
+ * non-empty runs are kept in a binary heap, so the merge is one pass
+ * costing O(n log k) for n records in k runs; null and empty runs cost
+ * nothing after the first look.
+ *
+ * Each group of records with the same timestamp produces one output
+ * record, chosen by @p policy, or none with DUPLICATE_REJECT. Every record
+ * of a group except the first read counts as a duplicate; with
+ * DUPLICATE_REJECT the first one counts as well.
+ *
+ * @param runs    Runs sorted by timestamp (see SortByTime()); null entries are empty.
+ * @param policy  Which record a group of duplicates keeps.
+ * @param out     Receives the merged records; cleared first.
+ * @param dropped If not null, receives the duplicates counted against each run.
+ * @return Total number of duplicates.
+ */
+int MergeSortedRuns(const Vector<const Vector<RecNode>*>& runs, DuplicatePolicy policy,
+                    Vector<RecNode>& out, Vector<int>* dropped = nullptr);
+
+#endif // RECSORT_H_INCLUDED
@@ -0,0 +1,224 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include "RecSort.h"
+using namespace std;
+
+// Small wrapper to display [OK] / [FAIL] for each test condition
+void Assert(bool condition, const string& message)
+{
+    if (!condition)
+    {
+        cout << "[FAIL] " << message << endl;
+    }
+    else
+    {
+        cout << "[OK] " << message << endl;
+    }
+}
+
+// Builds a record at the given time, tagged by its speed
+RecNode MakeNode(int year, int month, int day, int hour, int minute, float speed)
+{
+    return RecNode(PackDateTime(year, month, day, hour, minute), speed, 100.0f, 20.0f);
+}
+
+// True if the keys never decrease
+bool KeysAscending(Vector<RecNode>& nodes)
+{
+    for (int i = 1; i < nodes.GetSize(); i++)
+    {
+        if (nodes[i] < nodes[i - 1])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Verifies that one month of shuffled records comes out in time order
+void TestSortMonth()
+{
+    cout << "\n=== TestSortMonth ===\n";
+    Vector<RecNode> nodes;
+    srand(11);
+    for (int i = 0; i < 2000; i++)
+    {
+        nodes.PushBack(MakeNode(2016, 3, 1 + rand() % 31, rand() % 24, rand() % 60, 0.0f));
+    }
+
+    SortByTime(nodes);
+    Assert(nodes.GetSize() == 2000 && KeysAscending(nodes), "2000 shuffled records sorted");
+}
+
+// Verifies that records with the same timestamp keep their order
+void TestStable()
+{
+    cout << "\n=== TestStable ===\n";
+    Vector<RecNode> nodes;
+    nodes.PushBack(MakeNode(2016, 3, 31, 9, 0, 1.0f));
+    nodes.PushBack(MakeNode(2016, 3, 31, 8, 0, 2.0f));
+    nodes.PushBack(MakeNode(2016, 3, 31, 9, 0, 3.0f));
+    nodes.PushBack(MakeNode(2016, 3, 31, 8, 0, 4.0f));
+
+    SortByTime(nodes);
+    Assert(nodes[0].rec.GetSpeed() == 2.0f && nodes[1].rec.GetSpeed() == 4.0f, "Earlier duplicate first (08:00)");
+    Assert(nodes[2].rec.GetSpeed() == 1.0f && nodes[3].rec.GetSpeed() == 3.0f, "Earlier duplicate first (09:00)");
+}
+
+// Verifies sorting across years and months, where more key bytes differ
+void TestSortYears()
+{
+    cout << "\n=== TestSortYears ===\n";
+    Vector<RecNode> nodes;
+    nodes.PushBack(MakeNode(2021, 3, 31, 0, 0, 0.0f));
+    nodes.PushBack(MakeNode(2007, 12, 1, 0, 0, 0.0f));
+    nodes.PushBack(MakeNode(2016, 1, 5, 23, 50, 0.0f));
+    nodes.PushBack(MakeNode(2007, 1, 1, 0, 10, 0.0f));
+    nodes.PushBack(MakeNode(2300, 6, 15, 12, 0, 0.0f));
+
+    SortByTime(nodes);
+    Assert(KeysAscending(nodes), "Mixed years sorted");
+    Assert(nodes[0].GetKey().GetYear() == 2007 && nodes[0].GetKey().GetMonth() == 1 && nodes[4].GetKey().GetYear() == 2300,
+           "Earliest and latest at the ends");
+
+    Vector<RecNode> empty;
+    SortByTime(empty);
+    Assert(empty.GetSize() == 0, "Empty input left empty");
+}
+
+// Verifies that every month of a set of partitions is sorted
+void TestSortPartitions()
+{
+    cout << "\n=== TestSortPartitions ===\n";
+    RecPartitions data;
+    for (int i = 0; i < 300; i++)
+    {
+        int month = 1 + i % 12;
+        data[2007][month].PushBack(MakeNode(2007, month, 28 - i % 28, i % 24, 0, 0.0f));
+    }
+
+    SortPartitions(data, 4);
+    bool sorted = true;
+    for (int month = 1; month <= 12; month++)
+    {
+        sorted = sorted && data[2007][month].GetSize() == 25 && KeysAscending(data[2007][month]);
+    }
+    Assert(sorted, "All twelve months sorted");
+}
+
+// Two overlapping runs: 1:00 in both, 2:00 twice in the second run
+void MakeRuns(Vector<RecNode>& a, Vector<RecNode>& b)
+{
+    a.PushBack(MakeNode(2016, 3, 31, 0, 0, 1.0f));
+    a.PushBack(MakeNode(2016, 3, 31, 1, 0, 2.0f));
+    b.PushBack(MakeNode(2016, 3, 31, 1, 0, 4.0f));
+    b.PushBack(MakeNode(2016, 3, 31, 2, 0, 5.0f));
+    b.PushBack(MakeNode(2016, 3, 31, 2, 0, 7.0f));
+    b.PushBack(MakeNode(2016, 3, 31, 3, 0, 8.0f));
+}
+
+// Verifies every duplicate policy and the per-run duplicate counts
+void TestMergePolicies()
+{
+    cout << "\n=== TestMergePolicies ===\n";
+    Vector<RecNode> a, b;
+    MakeRuns(a, b);
+    Vector<const Vector<RecNode>*> runs;
+    runs.PushBack(&a);
+    runs.PushBack(nullptr);
+    runs.PushBack(&b);
+
+    Vector<RecNode> out;
+    Vector<int> dropped;
+    int duplicates = MergeSortedRuns(runs, DUPLICATE_FIRST_WINS, out, &dropped);
+    Assert(duplicates == 2 && out.GetSize() == 4 && KeysAscending(out), "First wins: four unique records");
+    Assert(out[1].rec.GetSpeed() == 2.0f && out[2].rec.GetSpeed() == 5.0f, "First wins: earliest read kept");
+    Assert(dropped[0] == 0 && dropped[1] == 0 && dropped[2] == 2, "First wins: duplicates counted against the later run");
+
+    MergeSortedRuns(runs, DUPLICATE_LAST_WINS, out);
+    Assert(out[1].rec.GetSpeed() == 4.0f && out[2].rec.GetSpeed() == 7.0f, "Last wins: latest read kept");
+
+    MergeSortedRuns(runs, DUPLICATE_AVERAGE, out);
+    Assert(out.GetSize() == 4 && out[1].rec.GetSpeed() == 3.0f && out[2].rec.GetSpeed() == 6.0f,
+           "Average: readings averaged");
+
+    duplicates = MergeSortedRuns(runs, DUPLICATE_REJECT, out, &dropped);
+    Assert(duplicates == 4 && out.GetSize() == 2, "Reject: both repeated timestamps dropped");
+    Assert(out[0].rec.GetSpeed() == 1.0f && out[1].rec.GetSpeed() == 8.0f, "Reject: unique records kept");
+    Assert(dropped[0] == 1 && dropped[2] == 3, "Reject: every copy counted");
+
+    Vector<const Vector<RecNode>*> none;
+    Assert(MergeSortedRuns(none, DUPLICATE_FIRST_WINS, out) == 0 && out.GetSize() == 0, "No runs, no records");
+}
+
+// Verifies the merge of many runs against a count done per timestamp
+void TestMergeManyRuns()
+{
+    cout << "\n=== TestMergeManyRuns ===\n";
+    // Run r has the hours divisible by r + 1, tagged with speed r; run 4 is
+    // null and run 6 empty
+    const int runCount = 9;
+    Vector<RecNode> data[runCount];
+    Vector<const Vector<RecNode>*> runs;
+    for (int r = 0; r < runCount; r++)
+    {
+        for (int hour = 0; hour < 24 && r != 6; hour += r + 1)
+        {
+            data[r].PushBack(MakeNode(2016, 3, 31, hour, 0, static_cast<float>(r)));
+        }
+        runs.PushBack((r == 4) ? nullptr : &data[r]);
+    }
+
+    Vector<RecNode> first, last;
+    Vector<int> dropped;
+    int duplicates = MergeSortedRuns(runs, DUPLICATE_FIRST_WINS, first, &dropped);
+    MergeSortedRuns(runs, DUPLICATE_LAST_WINS, last);
+
+    bool kept = first.GetSize() == 24 && last.GetSize() == 24;
+    int expected[runCount] = {0};
+    int expectedTotal = 0;
+    for (int hour = 0; hour < 24 && kept; hour++)
+    {
+        int lowest = -1, highest = -1;
+        for (int r = 0; r < runCount; r++)
+        {
+            if (runs[r] == nullptr || r == 6 || hour % (r + 1) != 0)
+            {
+                continue;
+            }
+            if (lowest == -1)
+            {
+                lowest = r;
+            }
+            else
+            {
+                expected[r]++;
+                expectedTotal++;
+            }
+            highest = r;
+        }
+        kept = first[hour].rec.GetSpeed() == lowest && last[hour].rec.GetSpeed() == highest;
+    }
+    Assert(kept && KeysAscending(first), "Earliest and latest run kept per timestamp");
+
+    bool counted = duplicates == expectedTotal;
+    for (int r = 0; r < runCount; r++)
+    {
+        counted = counted && dropped[r] == expected[r];
+    }
+    Assert(counted, "Duplicates counted against the right runs");
+}
+
+int main()
+{
+    TestSortMonth();
+    TestStable();
+    TestSortYears();
+    TestSortPartitions();
+    TestMergePolicies();
+    TestMergeManyRuns();
+
+    cout << "\n=== ALL TESTS COMPLETE ===\n";
+    return 0;
+}
@@ -3,6 +3,12 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <utility>
+#include <type_traits>
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 
 using std::out_of_range;
 
@@ -35,6 +41,13 @@ public:
      */
     Vector(const Vector<T>& other);
 
+    /**
+     * @brief Move constructor
+     * Takes the array of another vector, leaving it empty.
+     * @param other Vector to move from
+     */
+    Vector(Vector<T>&& other) noexcept;
+
     /**
      * @brief Destructor
      * Frees dynamically allocated memory.
@@ -48,6 +61,14 @@ public:
      */
     Vector<T>& operator=(const Vector<T>& other);
 
+    /**
+     * @brief Move assignment operator
+     * Frees this vector's array and takes the array of @p other.
+     * @param other Vector to move from; left empty
+     * @return Reference to this vector
+     */
+    Vector<T>& operator=(Vector<T>&& other) noexcept;
+
     /**
      * @brief Inserts a value at a given index
      * @param index Position to insert at (0-based)
@@ -56,6 +77,22 @@ public:
      */
     bool Insert(int index, const T& value);
 
+    /**
+     * @brief Inserts a value at a given index by moving it
+     * @param index Position to insert at (0-based)
+     * @param value Value to move in
+     * @return true if insertion succeeded, false if index invalid
+     */
+    bool Insert(int index, T&& value);
+
+    /**
+     * @brief Constructs a value from @p args and appends it
+     * @param args Arguments forwarded to the constructor of T
+     * @return Reference to the new element
+     */
+    template <class... Args>
+    T& EmplaceBack(Args&&... args);
+
     /**
      * @brief Deletes the element at a given index
      * @param index Position to delete (0-based)
@@ -85,22 +122,135 @@ public:
      */
     const T& operator[](int index) const;
 
+    /**
+     * @brief Access element at a given index, bounds-checked only in debug builds
+     * With NDEBUG defined this is a plain array access.
+     * @param index Position of the element
+     * @return Reference to element at index
+     * @throws out_of_range if index is invalid and NDEBUG is not defined
+     */
+    T& GetUnchecked(int index);
+
+    /**
+     * @brief Access element at a given index, bounds-checked only in debug builds (const version)
+     * @param index Position of the element
+     * @return Const reference to element at index
+     * @throws out_of_range if index is invalid and NDEBUG is not defined
+     */
+    const T& GetUnchecked(int index) const;
+
+    /**
+     * @brief Pointer to the elements, stored contiguously
+     * @return Pointer to the first element; null after the vector is moved from
+     */
+    T* Data();
+
+    /**
+     * @brief Pointer to the elements (const version)
+     * @return Pointer to the first element; null after the vector is moved from
+     */
+    const T* Data() const;
+
+    typedef T* Iterator;            /**< Element iterator (a plain pointer) */
+    typedef const T* ConstIterator; /**< Const element iterator */
+
+    /**
+     * @brief Iterator to the first element, for range-for loops
+     */
+    Iterator begin();
+
+    /**
+     * @brief Iterator one past the last element
+     */
+    Iterator end();
+
+    /**
+     * @brief Iterator to the first element (const version)
+     */
+    ConstIterator begin() const;
+
+    /**
+     * @brief Iterator one past the last element (const version)
+     */
+    ConstIterator end() const;
+
 private:
     T* m_array;        /**< Pointer to dynamic array */
     int m_size;        /**< Number of elements stored */
     int m_capacity;    /**< Allocated capacity */
 
+    /**
+     * @brief True if elements can live in raw memory and be copied bytewise
+     * Such vectors never construct unused slots, grow with realloc and
+     * shift with memmove. Over-aligned types keep the generic path, since
+     * malloc only guarantees max_align_t alignment.
+     */
+    static const bool trivial = std::is_trivially_copyable<T>::value
+                                && alignof(T) <= alignof(std::max_align_t);
+
+    typedef std::integral_constant<bool, trivial> Trivial; /**< Selects the storage helpers */
+
     /**
      * @brief Resizes the vector if it is more than half full
+     * Elements are moved, not copied, into the new array.
      */
     void Resize();
+
+    /**
+     * @brief Opens a gap at @p index by moving later elements up one place
+     * @param index Position of the gap; must be within [0, size]
+     */
+    void OpenGap(int index);
+
+    /**
+     * @brief Allocates an array of @p capacity slots
+     * Trivially copyable elements get uninitialised memory; others are
+     * default-constructed.
+     */
+    static T* Allocate(int capacity, std::true_type);
+    static T* Allocate(int capacity, std::false_type);
+
+    /**
+     * @brief Frees an array made by Allocate or Grow
+     */
+    static void Free(T* array, std::true_type);
+    static void Free(T* array, std::false_type);
+
+    /**
+     * @brief Replaces @p array by one of @p capacity slots holding its first @p size elements
+     * @return The new array; @p array must no longer be used
+     */
+    static T* Grow(T* array, int size, int capacity, std::true_type);
+    static T* Grow(T* array, int size, int capacity, std::false_type);
+
+    /**
+     * @brief Puts a T made from @p args into an unused slot
+     * Raw memory is constructed in place; a slot of new T[] already holds
+     * an object, so it is assigned a temporary instead.
+     */
+    template <class... Args>
+    static void Construct(std::true_type, T* slot, Args&&... args);
+    template <class... Args>
+    static void Construct(std::false_type, T* slot, Args&&... args);
+
+    /**
+     * @brief Copies @p count elements into another array
+     */
+    static void CopyElements(T* to, const T* from, int count, std::true_type);
+    static void CopyElements(T* to, const T* from, int count, std::false_type);
+
+    /**
+     * @brief Moves @p count elements within one array; the ranges may overlap
+     */
+    static void ShiftElements(T* to, T* from, int count, std::true_type);
+    static void ShiftElements(T* to, T* from, int count, std::false_type);
 };
 
 template <class T>
 Vector<T>::Vector()
 {
     m_capacity = INITIAL_CAPACITY;
-    m_array = new T[m_capacity];
+    m_array = Allocate(m_capacity, Trivial());
     m_size = 0;
 }
 
@@ -108,7 +258,7 @@ template <class T>
 Vector<T>::Vector(int n)
 {
     m_capacity = (n > 0) ? n : INITIAL_CAPACITY;
-    m_array = new T[m_capacity];
+    m_array = Allocate(m_capacity, Trivial());
     m_size = 0;
 }
 
@@ -120,20 +270,29 @@ Vector<T>::Vector(const Vector<T>& other)
 
     if(m_capacity > 0)
     {
-        m_array = new T[m_capacity];
-        for(int i = 0; i < m_size; i++)
-        {
-            m_array[i] = other.m_array[i];
-        }
+        m_array = Allocate(m_capacity, Trivial());
+        CopyElements(m_array, other.m_array, m_size, Trivial());
     }
     else
         m_array = nullptr;
 }
 
+template <class T>
+Vector<T>::Vector(Vector<T>&& other) noexcept
+{
+    m_array = other.m_array;
+    m_size = other.m_size;
+    m_capacity = other.m_capacity;
+
+    other.m_array = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
+}
+
 template <class T>
 Vector<T>::~Vector()
 {
-    delete[] m_array;
+    Free(m_array, Trivial());
 }
 
 template <class T>
@@ -144,18 +303,15 @@ Vector<T>& Vector<T>::operator=(const Vector<T>& other)
         return *this;
     }
 
-    delete[] m_array;
+    Free(m_array, Trivial());
 
     m_size = other.m_size;
     m_capacity = other.m_capacity;
 
     if(m_capacity > 0)
     {
-        m_array = new T[m_capacity];
-        for(int i = 0; i < m_size; i++)
-        {
-            m_array[i] = other.m_array[i];
-        }
+        m_array = Allocate(m_capacity, Trivial());
+        CopyElements(m_array, other.m_array, m_size, Trivial());
     }
     else
     {
@@ -165,20 +321,35 @@ Vector<T>& Vector<T>::operator=(const Vector<T>& other)
     return *this;
 }
 
+template <class T>
+Vector<T>& Vector<T>::operator=(Vector<T>&& other) noexcept
+{
+    if(this == &other)
+    {
+        return *this;
+    }
+
+    Free(m_array, Trivial());
+
+    m_array = other.m_array;
+    m_size = other.m_size;
+    m_capacity = other.m_capacity;
+
+    other.m_array = nullptr;
+    other.m_size = 0;
+    other.m_capacity = 0;
+
+    return *this;
+}
+
 template <class T>
 void Vector<T>::Resize()
 {
-    if(m_size > m_capacity / 2)
+    // A moved-from vector has no array at all
+    if(m_capacity == 0 || m_size > m_capacity / 2)
     {
         int newCapacity = (m_capacity == 0) ? 1 : m_capacity * 2;
-        T* newArray = new T[newCapacity];
-        for(int i = 0; i < m_size; i++)
-        {
-            newArray[i] = m_array[i];
-        }
-        delete[] m_array;
-        m_array = nullptr;
-        m_array = newArray;
+        m_array = Grow(m_array, m_size, newCapacity, Trivial());
         m_capacity = newCapacity;
     }
 }
@@ -191,17 +362,44 @@ bool Vector<T>::Insert(int index, const T& value)
         return false;
     }
 
-    Resize();
-    for(int i = m_size - 1; i >= index; i--)
+    OpenGap(index);
+    m_array[index] = value;
+    m_size++;
+    return true;
+}
+
+template <class T>
+bool Vector<T>::Insert(int index, T&& value)
+{
+    if(index < 0 || index > m_size)
     {
-        m_array[i + 1] = m_array[i];
+        return false;
     }
 
-    m_array[index] = value;
+    OpenGap(index);
+    m_array[index] = std::move(value);
     m_size++;
     return true;
 }
 
+template <class T>
+template <class... Args>
+T& Vector<T>::EmplaceBack(Args&&... args)
+{
+    Resize();
+    T* slot = m_array + m_size;
+    Construct(Trivial(), slot, std::forward<Args>(args)...);
+    m_size++;
+    return *slot;
+}
+
+template <class T>
+void Vector<T>::OpenGap(int index)
+{
+    Resize();
+    ShiftElements(m_array + index + 1, m_array + index, m_size - index, Trivial());
+}
+
 template <class T>
 bool Vector<T>::Delete(int index)
 {
@@ -210,13 +408,131 @@ bool Vector<T>::Delete(int index)
         return false;
     }
 
-    for(int i = index; i < m_size - 1; i++)
+    ShiftElements(m_array + index, m_array + index + 1, m_size - index - 1, Trivial());
+    m_size--;
+    return true;
+}
+
+// --- Storage for trivially copyable elements ---
+//
+// The array is raw malloc'd memory: nothing is constructed or destroyed,
+// growth is a realloc, and copies and shifts are single memcpy/memmove calls.
+
+template <class T>
+T* Vector<T>::Allocate(int capacity, std::true_type)
+{
+    T* array = static_cast<T*>(std::malloc(sizeof(T) * capacity));
+    if(array == nullptr)
     {
-        m_array[i] = m_array[i + 1];
+        throw std::bad_alloc();
     }
+    return array;
+}
 
-    m_size--;
-    return true;
+template <class T>
+void Vector<T>::Free(T* array, std::true_type)
+{
+    std::free(array);
+}
+
+template <class T>
+T* Vector<T>::Grow(T* array, int, int capacity, std::true_type)
+{
+    T* grown = static_cast<T*>(std::realloc(array, sizeof(T) * capacity));
+    if(grown == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return grown;
+}
+
+template <class T>
+template <class... Args>
+void Vector<T>::Construct(std::true_type, T* slot, Args&&... args)
+{
+    new (slot) T(std::forward<Args>(args)...);
+}
+
+template <class T>
+void Vector<T>::CopyElements(T* to, const T* from, int count, std::true_type)
+{
+    if(count > 0)
+    {
+        std::memcpy(to, from, sizeof(T) * count);
+    }
+}
+
+template <class T>
+void Vector<T>::ShiftElements(T* to, T* from, int count, std::true_type)
+{
+    if(count > 0)
+    {
+        std::memmove(to, from, sizeof(T) * count);
+    }
+}
+
+// --- Storage for every other element type ---
+//
+// Every slot of the array holds a constructed T, so elements are only
+// ever assigned, one at a time.
+
+template <class T>
+T* Vector<T>::Allocate(int capacity, std::false_type)
+{
+    return new T[capacity];
+}
+
+template <class T>
+void Vector<T>::Free(T* array, std::false_type)
+{
+    delete[] array;
+}
+
+template <class T>
+T* Vector<T>::Grow(T* array, int size, int capacity, std::false_type)
+{
+    T* grown = new T[capacity];
+    for(int i = 0; i < size; i++)
+    {
+        grown[i] = std::move(array[i]);
+    }
+    delete[] array;
+    return grown;
+}
+
+template <class T>
+template <class... Args>
+void Vector<T>::Construct(std::false_type, T* slot, Args&&... args)
+{
+    *slot = T(std::forward<Args>(args)...);
+}
+
+template <class T>
+void Vector<T>::CopyElements(T* to, const T* from, int count, std::false_type)
+{
+    for(int i = 0; i < count; i++)
+    {
+        to[i] = from[i];
+    }
+}
+
+template <class T>
+void Vector<T>::ShiftElements(T* to, T* from, int count, std::false_type)
+{
+    if(to < from)
+    {
+        for(int i = 0; i < count; i++)
+        {
+            to[i] = std::move(from[i]);
+        }
+    }
+    else
+    {
+        for(int i = count - 1; i >= 0; i--)
+        {
+            to[i] = std::move(from[i]);
+        }
+    }
 }
 
 template <class T>
@@ -239,10 +555,75 @@ const T& Vector<T>::operator[](int index) const
     return m_array[index];
 }
 
+template <class T>
+T& Vector<T>::GetUnchecked(int index)
+{
+#ifndef NDEBUG
+    if(index < 0 || index >= m_size)
+    {
+        throw out_of_range("Index out of bounds");
+    }
+#endif
+    return m_array[index];
+}
+
+template <class T>
+const T& Vector<T>::GetUnchecked(int index) const
+{
+#ifndef NDEBUG
+    if(index < 0 || index >= m_size)
+    {
+        throw out_of_range("Index out of bounds");
+    }
+#endif
+    return m_array[index];
+}
+
+template <class T>
+T* Vector<T>::Data()
+{
+    return m_array;
+}
+
+template <class T>
+const T* Vector<T>::Data() const
+{
+    return m_array;
+}
+
+template <class T>
+typename Vector<T>::Iterator Vector<T>::begin()
+{
+    return m_array;
+}
+
+template <class T>
+typename Vector<T>::Iterator Vector<T>::end()
+{
+    return m_array + m_size;
+}
+
+template <class T>
+typename Vector<T>::ConstIterator Vector<T>::begin() const
+{
+    return m_array;
+}
+
+template <class T>
+typename Vector<T>::ConstIterator Vector<T>::end() const
+{
+    return m_array + m_size;
+}
+
 template <class T>
 int Vector<T>::GetSize() const
 {
     return m_size;
 }
 
+// Containers of vectors move them on growth only if the move cannot throw
+static_assert(std::is_nothrow_move_constructible<Vector<int> >::value &&
+              std::is_nothrow_move_assignable<Vector<int> >::value,
+              "Vector moves must be noexcept");
+
 #endif // VECTOR_H_INCLUDED
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <type_traits>
+#include "Vector.h"
+using namespace std;
+
+// A record shaped like RecNode: a packed timestamp and three readings
+struct Record
+{
+    unsigned long long key;
+    float speed;
+    float solar;
+    float temp;
+};
+
+// The same bytes as T, but with a user-written copy, so Vector<Boxed<T> >
+// takes the generic element-by-element path the fast path is timed against
+template <class T>
+struct Boxed
+{
+    T value;
+
+    Boxed() : value() {}
+    Boxed(const T& v) : value(v) {}
+    Boxed(const Boxed& other) : value(other.value) {}
+    Boxed& operator=(const Boxed& other)
+    {
+        value = other.value;
+        return *this;
+    }
+};
+
+static_assert(std::is_trivially_copyable<Record>::value, "Record must take the fast path");
+static_assert(!std::is_trivially_copyable<Boxed<Record> >::value, "Boxed must take the generic path");
+
+// Checksum of the elements read back, so work cannot be optimised away
+unsigned long long g_check = 0;
+
+unsigned long long KeyOf(int x) { return static_cast<unsigned long long>(x); }
+unsigned long long KeyOf(const Record& r) { return r.key; }
+template <class T>
+unsigned long long KeyOf(const Boxed<T>& b) { return KeyOf(b.value); }
+
+// Builds the i-th element
+void Make(int i, int& out) { out = i; }
+void Make(int i, Record& out) { out.key = i; out.speed = i * 0.5f; out.solar = i * 2.0f; out.temp = i * 0.25f; }
+template <class T>
+void Make(int i, Boxed<T>& out) { Make(i, out.value); }
+
+// Milliseconds since start
+double ElapsedMs(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// Times appends, copies, front inserts and front deletes on one element type
+template <class T>
+void Run(const string& name, int count, int shifts)
+{
+    T element;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Vector<T> vec;
+    for (int i = 0; i < count; i++)
+    {
+        Make(i, element);
+        vec.Insert(vec.GetSize(), element);
+    }
+    double appendMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    Vector<T> copy(vec);
+    double copyMs = ElapsedMs(start);
+    g_check += KeyOf(copy[count - 1]);
+
+    // Every front insert or delete shifts the whole vector by one place
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < shifts; i++)
+    {
+        Make(-i, element);
+        vec.Insert(0, element);
+    }
+    double insertMs = ElapsedMs(start);
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < shifts; i++)
+    {
+        vec.Delete(0);
+    }
+    double deleteMs = ElapsedMs(start);
+
+    for (int i = 0; i < vec.GetSize(); i += 1024)
+    {
+        g_check += KeyOf(vec[i]);
+    }
+
+    cout << name
+         << " | append " << appendMs << " ms"
+         << " | copy " << copyMs << " ms"
+         << " | insert front " << insertMs << " ms"
+         << " | delete front " << deleteMs << " ms" << endl;
+}
+
+// Usage: VectorBench [count]
+int main(int argc, char* argv[])
+{
+    int count = (argc > 1) ? stoi(argv[1]) : 2000000;
+    const int shifts = 200;
+
+    cout << "=== " << count << " elements, " << shifts << " front inserts/deletes ===\n";
+    Run<int>("int            (memmove)", count, shifts);
+    Run<Boxed<int> >("Boxed<int>     (generic)", count, shifts);
+    Run<Record>("Record         (memmove)", count, shifts);
+    Run<Boxed<Record> >("Boxed<Record>  (generic)", count, shifts);
+
+    cout << "(checksum " << g_check << ")" << endl;
+    return 0;
+}
@@ -18,6 +18,9 @@ void AccessTest();
 void AccessInvalidTest();
 void CopyTest();
 void AssignTest();
+void MoveTest();
+void EmplaceTest();
+void IteratorTest();
 
 int main()
 {
@@ -32,6 +35,9 @@ int main()
     AccessInvalidTest();
     CopyTest();
     AssignTest();
+    MoveTest();
+    EmplaceTest();
+    IteratorTest();
 
     cout << "==== End of Vector Tests ====" << endl;
     return 0;
@@ -164,3 +170,75 @@ void AssignTest()
 
     cout << endl << endl;
 }
+
+void MoveTest()
+{
+    cout << "Test 10: Move Constructor and Move Assignment" << endl;
+
+    Vector<int> source(myVector);
+    int size = source.GetSize();
+
+    Vector<int> moved(std::move(source));
+    cout << "Expected moved size: " << size << " | Actual: " << moved.GetSize() << endl;
+    cout << "Expected source size: 0 | Actual: " << source.GetSize() << endl;
+
+    Vector<int> assigned;
+    assigned.PushBack(-1);
+    assigned = std::move(moved);
+    cout << "Expected assigned size: " << size << " | Actual: " << assigned.GetSize() << endl;
+    cout << "Expected moved-from size: 0 | Actual: " << moved.GetSize() << endl;
+
+    // A moved-from vector can be filled again
+    moved.PushBack(7);
+    cout << "Expected 7 | Actual: " << moved[0] << endl << endl;
+}
+
+void EmplaceTest()
+{
+    cout << "Test 11: EmplaceBack" << endl;
+
+    Vector<Vector<int> > rows;
+    rows.EmplaceBack(3);
+    rows.EmplaceBack();
+    rows[1].EmplaceBack(9);
+
+    cout << "Expected sizes: 3 1 | Actual: " << rows[0].GetSize() << " " << rows[1].GetSize() << endl;
+    cout << "Expected 9 | Actual: " << rows[1][0] << endl << endl;
+}
+
+void IteratorTest()
+{
+    cout << "Test 12: Iterators, Data() and GetUnchecked()" << endl;
+
+    Vector<int> values;
+    for(int i = 1; i <= 4; i++)
+        values.PushBack(i * 10);
+
+    int sum = 0;
+    for(int value : values)
+        sum += value;
+    cout << "Expected range-for sum: 100 | Actual: " << sum << endl;
+
+    const int* data = values.Data();
+    cout << "Expected Data()[2]: 30 | Actual: " << data[2] << endl;
+    cout << "Expected end - begin: 4 | Actual: " << (values.end() - values.begin()) << endl;
+
+    values.GetUnchecked(3) = 45;
+    cout << "Expected GetUnchecked(3): 45 | Actual: " << values.GetUnchecked(3) << endl;
+
+#ifndef NDEBUG
+    // Debug builds still check the index
+    try
+    {
+        values.GetUnchecked(4);
+        cout << "GetUnchecked(4) did not throw (unexpected)" << endl;
+    }
+    catch(const out_of_range&)
+    {
+        cout << "GetUnchecked(4) threw out_of_range in a debug build (expected)" << endl;
+    }
+#endif
+
+    Vector<int> empty;
+    cout << "Expected empty range: 1 | Actual: " << (empty.begin() == empty.end()) << endl << endl;
+}
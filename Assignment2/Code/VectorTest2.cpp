@@ -9,6 +9,7 @@ using namespace std;
 int testIntVec(Vector<int> &vec);
 int testDateVecValue(Vector<Date> vec);      // pass by value
 int testDateVecRef(Vector<Date> &vec);       // pass by reference
+int testMoveVec();                           // move construct / assign
 
 // Template function to print a Vector (const reference)
 template <typename T>
@@ -31,6 +32,7 @@ int main()
     testIntVec(intVec);
     testDateVecValue(dateVec);   // pass by value (copy)
     testDateVecRef(dateVec);     // pass by reference (same object)
+    testMoveVec();
 
     return 0;
 }
@@ -101,3 +103,45 @@ int testDateVecRef(Vector<Date> &vec) // pass by reference
 
     return 0;
 }
+
+int testMoveVec()
+{
+    cout << "\nMove Test" << endl;
+
+    Vector<string> words;
+    for (int i = 0; i < 12; i++)   // grows past the initial capacity
+    {
+        words.EmplaceBack(3, static_cast<char>('a' + i));
+    }
+    words.Insert(0, string("first"));
+    printVec(words, "words");
+
+    // Move constructor takes the array; the source is left empty
+    Vector<string> moved(std::move(words));
+    cout << "moved size: " << moved.GetSize() << ", words size: " << words.GetSize() << endl;
+
+    // Move assignment; the moved-from vector can be filled again
+    words = std::move(moved);
+    moved.EmplaceBack("again");
+    printVec(words, "words after move back");
+    printVec(moved, "moved after refill");
+
+    // Range-for, Data() and unchecked access see the same elements
+    int letters = 0;
+    for (const string& word : words)
+    {
+        letters += word.size();
+    }
+    cout << "letters: " << letters << ", Data()[1]: " << words.Data()[1]
+         << ", GetUnchecked(12): " << words.GetUnchecked(12) << endl;
+
+    // Dates are trivially copyable: built in place in raw storage
+    Vector<Date> dates;
+    for (int day = 1; day <= 12; day++)
+    {
+        dates.EmplaceBack(day, 4, 2025);
+    }
+    printVec(dates, "dates built in place");
+
+    return 0;
+}
@@ -1,342 +1,591 @@
 #include "WeatherLog.h"
+#include "Parallel.h"
+#include "RecSort.h"
 #include <iostream>
 #include <fstream>
 #include <cmath>
 #include <string>
-#include <sstream>
-#include <stdexcept>
+#include <algorithm>
+#include <utility>
 
 using std::cout;
 using std::endl;
 using std::ofstream;
 using std::ifstream;
 using std::string;
-using std::stringstream;
-using std::stof;
-using std::invalid_argument;
-using std::out_of_range;
 
 // Default constructor: initializes an empty WeatherLog
-WeatherLog::WeatherLog() {}
+WeatherLog::WeatherLog(StorageMode storage) : m_storage(storage), m_duplicates(DUPLICATE_FIRST_WINS) {}
 
-// Utility functions
-// Check if a string represents a valid numeric value
-bool IsValidNumber(const string& s)
+// Result of reading one manifest entry, filled in on a worker thread
+struct FileLoad
 {
-    if(s.empty())
+    string path;           // data/<file name>
+    CsvReadStatus status;  // outcome of the read
+    int records;           // records parsed from this file
+    RecPartitions data;    // this file's records by year and month
+    Vector<CsvSpan> spans; // month ranges of the records (mapped mode only)
+    LoadStats stats;       // rows this file did not contribute, by reason
+    long long readTo;      // offset past the last complete row (mapped mode), or -1
+
+    FileLoad() : status(CSV_OPEN_FAILED), records(0), readTo(-1) {}
+};
+
+// Load weather data from CSV
+bool WeatherLog::LoadData(LoadMode mode, int threads, bool follow)
+{
+    // Data source file listing CSVs
+    string dataSourceFile = "data/data_source.txt";
+    ifstream sourceFile(dataSourceFile);
+    if(!sourceFile.is_open())
     {
+        cout << "Failed to open " << dataSourceFile << endl;
         return false;
     }
 
-    // Convert to lowercase to handle "NA", "N/A", "---", "-9999"
-    string lower;
-    for(size_t i = 0; i < s.size(); ++i)
+    Vector<string> csvFiles;
+    string csvFileName;
+    while(getline(sourceFile, csvFileName))
     {
-        char c = s[i];
-        if(c >= 'A' && c <= 'Z')
+        if(!csvFileName.empty())
         {
-            c = c - 'A' + 'a';
+            csvFiles.PushBack(csvFileName);
         }
-        lower += c;
     }
+    sourceFile.close();
+
+    // Threads left over after one per file go to chunked parsing inside each file
+    threads = ResolveThreadCount(threads);
+    int fileThreads = (csvFiles.GetSize() < threads) ? csvFiles.GetSize() : threads;
+    int chunkThreads = (fileThreads > 0) ? threads / fileThreads : 1;
 
-    if(lower == "na" || lower == "n/a" || lower == "---" || lower == "-9999")
+    // Parse every file into its own partitions, one file per worker
+    Vector<FileLoad> loads(csvFiles.GetSize());
+    ParallelFor(csvFiles.GetSize(), fileThreads, [&](int i)
     {
-        return false;
+        FileLoad& load = loads[i];
+        load.path = "data/" + csvFiles[i];
+        load.status = (mode == LOAD_MAPPED)
+                      ? ReadCsvMapped(load.path, load.data, load.records, chunkThreads,
+                                      &load.spans, &load.stats, follow ? &load.readTo : nullptr)
+                      : ReadCsvStream(load.path, load.data, load.records, &load.stats);
+
+        // Sort each month by time, so every month is built in one pass
+        SortPartitions(load.data, chunkThreads);
+    });
+
+    // Report in manifest order, so the output does not depend on thread timing
+    Vector<RecPartitions*> batch;
+    Vector<int> batchLoads;
+    for(int i = 0; i < loads.GetSize(); i++)
+    {
+        FileLoad& load = loads[i];
+        if(load.status == CSV_OPEN_FAILED)
+        {
+            cout << "Failed to open CSV File" << load.path << endl;
+            continue;
+        }
+
+        cout <<  "Reading " << load.path << "..." << endl;
+        if(load.status == CSV_MISSING_COLUMNS)
+        {
+            cout << "CSV missing required columns (WAST, S, T, SR) in " << load.path << endl;
+            continue;
+        }
+        batch.PushBack(&load.data);
+        batchLoads.PushBack(i);
     }
 
-    bool hasDigit = false, hasDot = false, hasE = false;
+    // Merge every file's runs month by month, in manifest order
+    Vector<int> dropped;
+    AddPartitions(batch, dropped);
+    int batchNumber = m_batchPolicies.GetSize();
+    m_batchPolicies.PushBack(m_duplicates);
 
-    for(size_t i = 0; i < s.size(); ++i)
+    int totalRecords = 0;
+    for(int b = 0; b < batchLoads.GetSize(); b++)
     {
-        char c = s[i];
-        if(c >= '0' && c <= '9')
+        FileLoad& load = loads[batchLoads[b]];
+        load.stats.AddRejects(REJECT_DUPLICATE, dropped[b]);
+        load.data.Clear();
+        totalRecords += load.records - dropped[b];
+
+        m_loadStats.Add(load.stats, 0);
+
+        // Remember where the rows are, for sensors read on demand; the
+        // load is finished with, so its buffers are handed over
+        SourceFile source;
+        source.path = load.path;
+        source.offset = load.readTo;
+        source.lines = load.stats.rows + 1;
+        source.heldBack = load.stats.rejects[REJECT_UNFINISHED] > 0;
+        source.spans = std::move(load.spans);
+        source.batchStarts.PushBack(0);
+        source.batches.PushBack(batchNumber);
+        source.stats = std::move(load.stats);
+        m_sources.PushBack(std::move(source));
+    }
+
+    cout << "Loaded total " << totalRecords << " records from all CSV files." << endl;
+    PrintLoadStats();
+    return true;
+}
+
+// Parse rows appended to the followed files and add them to their months
+int WeatherLog::PollAppendedData()
+{
+    int totalRecords = 0;
+    for(int i = 0; i < m_sources.GetSize(); i++)
+    {
+        SourceFile& source = m_sources[i];
+        if(source.offset < 0)
         {
-            hasDigit = true;
+            continue;
         }
-        else if(c == '.')
+
+        RecPartitions tempData;
+        Vector<CsvSpan> spans;
+        LoadStats stats;
+        int records = 0;
+        CsvReadStatus status = ReadCsvAppended(source.path, source.offset, tempData, records, &spans, &stats);
+        if(status == CSV_OPEN_FAILED)
         {
-            if(hasDot || hasE)
-            {
-                return false;
-            }
-            hasDot = true;
+            cout << "Failed to open CSV File" << source.path << endl;
+            continue;
         }
-        else if(c == 'e' || c == 'E')
+        if(status == CSV_MISSING_COLUMNS)
         {
-            if(hasE || !hasDigit || i + 1 == s.size())
-            {
-                return false;
-            }
-            hasE = true;
-            hasDigit = false;
+            cout << "CSV missing required columns (WAST, S, T, SR) in " << source.path << endl;
+            continue;
         }
-        else if(c == '+' || c == '-')
+        if(status == CSV_TRUNCATED)
         {
-            if (i > 0 && s[i - 1] != 'e' && s[i - 1] != 'E')
-            {
-                return false;
-            }
+            cout << source.path << " is shorter than before; it is no longer followed." << endl;
+            source.offset = -1;
+            continue;
         }
-        else
+
+        // A held-back row was read again from the offset; uncount the old count
+        if(source.heldBack)
         {
-            return false;
+            source.stats.Withdraw(REJECT_UNFINISHED, source.lines);
+            m_loadStats.Withdraw(REJECT_UNFINISHED, source.lines);
+            source.lines--;
         }
-    }
 
-    return hasDigit;
-}
+        SortPartitions(tempData, 1);
+        Vector<RecPartitions*> batch;
+        batch.PushBack(&tempData);
+        Vector<int> dropped;
+        AddPartitions(batch, dropped);
+        stats.AddRejects(REJECT_DUPLICATE, dropped[0]);
+        records -= dropped[0];
+        ForgetSensors(tempData);
 
-// Helper to build balanced BST
+        if(spans.GetSize() > 0)
+        {
+            source.batchStarts.PushBack(source.spans.GetSize());
+            source.batches.PushBack(m_batchPolicies.GetSize());
+            m_batchPolicies.PushBack(m_duplicates);
+        }
+        for(int s = 0; s < spans.GetSize(); s++)
+        {
+            source.spans.PushBack(spans[s]);
+        }
+        source.stats.Add(stats, source.lines);
+        source.lines += stats.rows;
+        source.heldBack = stats.rejects[REJECT_UNFINISHED] > 0;
+        m_loadStats.Add(stats, 0);
+
+        if(records > 0)
+        {
+            cout << "Added " << records << " new records from " << source.path << endl;
+        }
+        totalRecords += records;
+    }
+    return totalRecords;
+}
 
-// Recursively insert the middle element of a sorted vector to build a balanced BST
-void InsertMiddle(Bst<RecNode>& bst, Vector<RecNode>& nodes, int start, int end)
+// Drop stored sensor columns of the months that just received records
+void WeatherLog::ForgetSensors(RecPartitions& tempData)
 {
-    if(start > end)
+    Vector<string> codes;
+    m_sensors.GetKeys(codes);
+
+    Vector<int> yearKeys;
+    tempData.GetKeys(yearKeys);
+    for(int y = 0; y < yearKeys.GetSize(); y++)
     {
-        return;
+        Vector<int> monthKeys;
+        tempData[yearKeys[y]].GetKeys(monthKeys);
+        for(int m = 0; m < monthKeys.GetSize(); m++)
+        {
+            for(int c = 0; c < codes.GetSize(); c++)
+            {
+                if(m_sensors[codes[c]].Contains(yearKeys[y]))
+                {
+                    m_sensors[codes[c]][yearKeys[y]].Remove(monthKeys[m]);
+                }
+            }
+        }
     }
-
-    int mid = (start + end) / 2;
-    bst.Insert(nodes[mid]);
-    InsertMiddle(bst, nodes, start, mid - 1);
-    InsertMiddle(bst, nodes, mid + 1, end);
 }
 
-// Global traversal buffer and callback
+// Statistics of rows that were not loaded, over all files
+const LoadStats& WeatherLog::GetLoadStats() const
+{
+    return m_loadStats;
+}
 
-// Used to temporarily store nodes during in-order traversal
-static Vector<RecNode>* g_traverseBuffer = nullptr;
+// Choose which record is kept for a repeated timestamp
+void WeatherLog::SetDuplicatePolicy(DuplicatePolicy policy)
+{
+    m_duplicates = policy;
+}
 
-// Function pointer used as callback to collect RecNode during traversal
-static void CollectRecNode(const RecNode& node)
+// Which record is kept for a repeated timestamp
+DuplicatePolicy WeatherLog::GetDuplicatePolicy() const
 {
-    if (g_traverseBuffer != nullptr)
-    {
-        g_traverseBuffer->Insert(g_traverseBuffer->GetSize(), node);
-    }
+    return m_duplicates;
 }
 
-// Load weather data from CSV
-bool WeatherLog::LoadData()
+// Print one summary of the rejected rows, with sample line numbers per file
+void WeatherLog::PrintLoadStats() const
 {
-    // Data source file listing CSVs
-    string dataSourceFile = "data/data_source.txt";
-    ifstream sourceFile(dataSourceFile);
-    if(!sourceFile.is_open())
+    if(m_loadStats.TotalRejects() == 0)
     {
-        cout << "Failed to open " << dataSourceFile << endl;
-        return false;
+        return;
     }
 
-    string csvFileName;
-    int totalRecords = 0;
-
-    while(getline(sourceFile, csvFileName))
+    cout << "Skipped " << m_loadStats.TotalRejects() << " of "
+         << m_loadStats.rows << " data rows:" << endl;
+    for(int r = 0; r < REJECT_REASON_COUNT; r++)
     {
-        if(csvFileName.empty())
+        if(m_loadStats.rejects[r] == 0)
         {
             continue;
         }
 
-        string csvFilePath = "data/" + csvFileName;
-        ifstream csvFile(csvFilePath);
-        if(!csvFile.is_open())
-        {
-            cout << "Failed to open CSV File" << csvFilePath << endl;
-            continue;
-        }
-
-        cout <<  "Reading " << csvFilePath << "..." << endl;
-
-        // Read CSV header and map column indices
-        string headerLine;
-        getline(csvFile, headerLine);
-        stringstream headerStream(headerLine);
-        string col;
-        Vector<string> columns;
-
-        while(getline(headerStream, col, ','))
-        {
-            columns.Insert(columns.GetSize(), col);
-        }
-
-        int idxWAST = -1, idxWind = -1, idxTemp = -1, idxSolar = -1;
-        for(int i = 0; i < columns.GetSize(); i++)
+        cout << "  " << RejectReasonName(static_cast<RejectReason>(r)) << ": "
+             << m_loadStats.rejects[r] << endl;
+        for(int i = 0; i < m_sources.GetSize(); i++)
         {
-            if(columns[i] == "WAST")
+            const Vector<long long>& lines = m_sources[i].stats.lines[r];
+            if(m_sources[i].stats.rejects[r] == 0)
             {
-                idxWAST = i;
+                continue;
             }
-            else if(columns[i] == "S")
+
+            // Duplicates are found after parsing, so they have counts only
+            if(lines.GetSize() == 0)
             {
-                idxWind = i;
+                cout << "    " << m_sources[i].path << ": " << m_sources[i].stats.rejects[r]
+                     << " (line numbers not kept)" << endl;
+                continue;
             }
-            else if(columns[i] == "T")
+
+            cout << "    " << m_sources[i].path << " line";
+            for(int l = 0; l < lines.GetSize(); l++)
             {
-                idxTemp = i;
+                cout << ((l == 0) ? " " : ", ") << lines[l];
             }
-            else if(columns[i] == "SR")
+            if(m_sources[i].stats.rejects[r] > lines.GetSize())
             {
-                idxSolar = i;
+                cout << ", ...";
             }
+            cout << endl;
         }
+    }
+}
 
-        if(idxWAST == -1 || idxWind == -1 || idxTemp == -1 || idxSolar == -1)
+// Insert one record's readings into a month's value-ordered trees, skipping missing ones
+static void AddReadings(MonthValues& values, unsigned long long key, float speed, float temp, float solar)
+{
+    float readings[FIELD_COUNT];
+    readings[FIELD_SPEED] = speed;
+    readings[FIELD_TEMP] = temp;
+    readings[FIELD_SOLAR] = solar;
+    for(int f = 0; f < FIELD_COUNT; f++)
+    {
+        if(!std::isnan(readings[f]))
         {
-            cout << "CSV missing required columns (WAST, S, T, SR) in " << csvFilePath << endl;
-            csvFile.close();
-            continue;
+            SensorValue reading = {readings[f], key};
+            values.fields[f].Insert(reading);
         }
+    }
+}
 
-        // Temporary storage of records by year and month
-        Map<int, Map<int, Vector<RecNode>>> tempData;
-
-        // Read each row of CSV
-        string line;
-        while(getline(csvFile, line))
+// Merge each month of a batch of files and add the result to what is stored
+int WeatherLog::AddPartitions(const Vector<RecPartitions*>& batch, Vector<int>& dropped)
+{
+    // Every month that any file of the batch has records for
+    Map<int, Map<int, bool>> months;
+    for(int f = 0; f < batch.GetSize(); f++)
+    {
+        Vector<int> yearKeys;
+        batch[f]->GetKeys(yearKeys);
+        for(int y = 0; y < yearKeys.GetSize(); y++)
         {
-            stringstream ss(line);
-            string token;
-            Vector<string> row;
-
-            while(getline(ss, token, ','))
+            Vector<int> monthKeys;
+            (*batch[f])[yearKeys[y]].GetKeys(monthKeys);
+            for(int m = 0; m < monthKeys.GetSize(); m++)
             {
-                row.Insert(row.GetSize(), token);
+                months[yearKeys[y]][monthKeys[m]] = true;
             }
+        }
+    }
 
-            if(row.GetSize() != columns.GetSize())
+    dropped = Vector<int>(batch.GetSize());
+    int duplicates = 0;
+    Vector<int> yearKeys;
+    months.GetKeys(yearKeys);
+    for(int y = 0; y < yearKeys.GetSize(); y++)
+    {
+        int yearKey = yearKeys[y];
+        Vector<int> monthKeys;
+        months[yearKey].GetKeys(monthKeys);
+        for(int m = 0; m < monthKeys.GetSize(); m++)
+        {
+            int monthKey = monthKeys[m];
+            bool stored = HasMonth(yearKey, monthKey);
+
+            // Stored records were settled when they were added, so a row
+            // repeating a stored timestamp is a duplicate whatever the policy
+            Vector<Vector<RecNode>> kept(stored ? batch.GetSize() : 0);
+            Vector<const Vector<RecNode>*> runs;
+            for(int f = 0; f < batch.GetSize(); f++)
             {
-                continue;
+                RecPartitions& data = *batch[f];
+                bool has = data.Contains(yearKey) && data[yearKey].Contains(monthKey);
+                const Vector<RecNode>* run = has ? &data[yearKey][monthKey] : nullptr;
+                if(stored && run != nullptr)
+                {
+                    for(const RecNode& node : *run)
+                    {
+                        if(HasRecord(yearKey, monthKey, node.GetKey()))
+                        {
+                            dropped[f]++;
+                            duplicates++;
+                        }
+                        else
+                        {
+                            kept[f].PushBack(node);
+                        }
+                    }
+                    run = &kept[f];
+                }
+                runs.PushBack(run);
             }
 
-            // Parse date and time from WAST
-            string wast = row[idxWAST];
-            int day, month, year, hour, minute;
-            if(sscanf(wast.c_str(), "%d/%d/%d %d:%d", &day, &month, &year, &hour, &minute) != 5)
+            // The policy settles timestamps repeated among the new rows
+            Vector<RecNode> merged;
+            Vector<int> runDropped;
+            MergeSortedRuns(runs, m_duplicates, merged, &runDropped);
+            for(int f = 0; f < batch.GetSize(); f++)
             {
-                continue;
+                dropped[f] += runDropped[f];
+                duplicates += runDropped[f];
             }
 
-            // Skip row if any numeric fields are invalid
-            if(!IsValidNumber(row[idxWind]) ||
-                    !IsValidNumber(row[idxTemp]) ||
-                    !IsValidNumber(row[idxSolar]))
+            if(stored)
             {
-                continue;
+                AddToMonth(yearKey, monthKey, merged);
             }
-
-            try
+            else
             {
-                float wind = stof(row[idxWind]) * 3.6f;       // convert m/s to km/h
-                float temp = stof(row[idxTemp]);
-                float solar = stof(row[idxSolar]) * 0.0001667f; // convert W/m2 to kWh/m2
-
-                Date d(day, month, year);
-                Time t(hour, minute);
-                WeatherRec w(d, t, wind, solar, temp);
-                RecNode recNode(w);
-
-                if(!tempData.Contains(year))
-                {
-                    tempData[year] = Map<int, Vector<RecNode>>();
-                }
-                if(!tempData[year].Contains(month))
-                {
-                    tempData[year][month] = Vector<RecNode>();
-                }
-
-                tempData[year][month].Insert(tempData[year][month].GetSize(), recNode);
-                totalRecords++;
+                StoreMonth(yearKey, monthKey, merged);
             }
-            catch(const invalid_argument& e)
+            // Percentile trees already built take the new readings too
+            if(stored && m_values.Contains(yearKey) && m_values[yearKey].Contains(monthKey))
             {
-                cout << "Skipping invalid numeric conversion: " << line << endl;
-            }
-            catch(const out_of_range& e)
-            {
-                cout << "Skipping out-of-range numeric value: " << line << endl;
+                MonthValues& values = m_values[yearKey][monthKey];
+                for(const RecNode& node : merged)
+                {
+                    AddReadings(values, node.GetKey().GetPacked(), node.rec.GetSpeed(),
+                                node.rec.GetAmbAirTemp(), node.rec.GetSolarRad());
+                }
             }
         }
+    }
+    return duplicates;
+}
 
-        // Build BSTs for each month
-        Vector<int> yearKeys;
-        tempData.GetKeys(yearKeys);
-        for(int y = 0; y < yearKeys.GetSize(); y++)
+// Build a month that has no records yet from a sorted run of unique records
+void WeatherLog::StoreMonth(int year, int month, const Vector<RecNode>& merged)
+{
+    // Every record rejected: the month stays absent
+    if(merged.GetSize() == 0)
+    {
+        return;
+    }
+
+    if(m_storage == STORAGE_COLUMNAR)
+    {
+        MonthColumns& columns = m_columns[year][month];
+        for(const RecNode& node : merged)
         {
-            int yearKey = yearKeys[y];
-            if(!m_data.Contains(yearKey))
-            {
-                m_data[yearKey] = Map<int, Bst<RecNode>>();
-            }
+            columns.PushBack(node);
+        }
+        return;
+    }
 
-            Map<int, Vector<RecNode>>& months = tempData[yearKey];
-            Vector<int> monthKeys;
-            months.GetKeys(monthKeys);
+    // Already sorted and unique, so this is one linear pass
+    const RecNode* first = merged.Data();
+    m_data[year][month].BuildFromSorted(first, first + merged.GetSize());
+}
 
-            for(int m = 0; m < monthKeys.GetSize(); m++)
-            {
-                int monthKey = monthKeys[m];
-                Vector<RecNode>& nodes = months[monthKey];
+// Add sorted, unique records with new timestamps to a stored month
+void WeatherLog::AddToMonth(int year, int month, const Vector<RecNode>& added)
+{
+    if(added.GetSize() == 0)
+    {
+        return;
+    }
 
-                if(!m_data[yearKey].Contains(monthKey))
-                {
-                    m_data[yearKey][monthKey] = Bst<RecNode>();
-                }
+    if(m_storage == STORAGE_TREE)
+    {
+        // O(log n) per record; the cached aggregates are updated on the way
+        MonthTree& tree = m_data[year][month];
+        for(const RecNode& node : added)
+        {
+            tree.Insert(node);
+        }
+        return;
+    }
 
-                InsertMiddle(m_data[yearKey][monthKey], nodes, 0, nodes.GetSize() - 1);
-            }
+    // Rows appended by a logger come after every stored row
+    MonthColumns& columns = m_columns[year][month];
+    if(columns.keys.GetUnchecked(columns.GetSize() - 1) < added[0].GetKey().GetPacked())
+    {
+        for(const RecNode& node : added)
+        {
+            columns.PushBack(node);
         }
+        return;
+    }
+
+    // Otherwise interleave them; no timestamp is in both runs
+    Vector<RecNode> existing;
+    const unsigned long long* keys = columns.keys.Data();
+    const float* speeds = columns.speed.Data();
+    const float* temps = columns.temp.Data();
+    const float* solar = columns.solar.Data();
+    for(int i = 0; i < columns.GetSize(); i++)
+    {
+        existing.PushBack(RecNode(keys[i], speeds[i], solar[i], temps[i]));
+    }
+    Vector<const Vector<RecNode>*> runs;
+    runs.PushBack(&existing);
+    runs.PushBack(&added);
+    Vector<RecNode> merged;
+    MergeSortedRuns(runs, DUPLICATE_FIRST_WINS, merged);
+
+    columns.Clear();
+    for(const RecNode& node : merged)
+    {
+        columns.PushBack(node);
+    }
+}
 
-        csvFile.close();
+// Check whether a stored month has a record with this timestamp
+bool WeatherLog::HasRecord(int year, int month, const DateTimeKey& key) const
+{
+    if(m_storage == STORAGE_TREE)
+    {
+        return m_data.At(year).At(month).Search(RecNode(key));
     }
 
-    sourceFile.close();
-    cout << "Loaded total " << totalRecords << " records from all CSV files." << endl;
-    return true;
+    const MonthColumns& columns = m_columns.At(year).At(month);
+    const unsigned long long* keys = columns.keys.Data();
+    int size = columns.GetSize();
+    return std::binary_search(keys, keys + size, key.GetPacked());
 }
 
-// Display average wind speed and standard deviation for a specific month/year
-void WeatherLog::DisplayAvgSpeed(int month, int year)
+// Check whether a year has records
+bool WeatherLog::HasYear(int year) const
+{
+    return (m_storage == STORAGE_COLUMNAR) ? m_columns.Contains(year) : m_data.Contains(year);
+}
+
+// Check whether a month has records
+bool WeatherLog::HasMonth(int year, int month) const
 {
-    if (!m_data.Contains(year) || !m_data[year].Contains(month))
+    if(m_storage == STORAGE_COLUMNAR)
     {
-        cout << "No data for " << month << "/" << year << endl;
-        return;
+        return m_columns.Contains(year) && m_columns.At(year).Contains(month);
     }
+    return m_data.Contains(year) && m_data.At(year).Contains(month);
+}
 
-    // Collect all nodes in-order
-    Vector<RecNode> nodes;
-    g_traverseBuffer = &nodes;
-    m_data[year][month].InOrder(CollectRecNode);
-    g_traverseBuffer = nullptr;
+// List the years with records
+void WeatherLog::GetYearKeys(Vector<int>& out) const
+{
+    if(m_storage == STORAGE_COLUMNAR)
+    {
+        m_columns.GetKeys(out);
+    }
+    else
+    {
+        m_data.GetKeys(out);
+    }
+}
 
-    if(nodes.GetSize() == 0)
+// List the months of a year with records
+void WeatherLog::GetMonthKeys(int year, Vector<int>& out) const
+{
+    out.Clear();
+    if(!HasYear(year))
     {
         return;
     }
+    if(m_storage == STORAGE_COLUMNAR)
+    {
+        m_columns.At(year).GetKeys(out);
+    }
+    else
+    {
+        m_data.At(year).GetKeys(out);
+    }
+}
 
-    // Extract speeds
-    Vector<float> speeds;
-    for(int i = 0; i < nodes.GetSize(); i++)
+// Get a month as sorted columns, streaming the BST in order when needed
+const MonthColumns* WeatherLog::GetMonth(int year, int month, MonthColumns& scratch)
+{
+    if(!HasMonth(year, month))
+    {
+        return nullptr;
+    }
+    if(m_storage == STORAGE_COLUMNAR)
     {
-        speeds.Insert(speeds.GetSize(), nodes[i].rec.GetSpeed());
+        return &m_columns[year][month];
     }
 
-    // Compute mean and standard deviation
-    float sum = 0;
-    for(int i = 0; i < speeds.GetSize(); i++)
+    scratch.Clear();
+    const MonthTree& tree = m_data[year][month];
+    for(MonthTree::Iterator it = tree.begin(); it != tree.end(); ++it)
     {
-        sum += speeds[i];
+        scratch.PushBack(*it);
     }
-    float avg = sum / speeds.GetSize();
+    return &scratch;
+}
 
-    float sumSq = 0;
-    for(int i = 0; i < speeds.GetSize(); i++)
+// Display average wind speed and standard deviation for a specific month/year
+void WeatherLog::DisplayAvgSpeed(int month, int year)
+{
+    RecSummary summary;
+    if(!SummarizeMonth(year, month, summary))
     {
-        sumSq += (speeds[i] - avg) * (speeds[i] - avg);
+        cout << "No data for " << month << "/" << year << endl;
+        return;
+    }
+    if(summary.GetCount() == 0)
+    {
+        return;
     }
-    float sd = (speeds.GetSize() > 1) ? sqrt(sumSq / (speeds.GetSize() - 1)) : 0;
+
+    // Mean and standard deviation from the month's aggregates
+    float avg = static_cast<float>(summary.GetMean(FIELD_SPEED));
+    float sd = static_cast<float>(summary.GetSd(FIELD_SPEED));
 
     cout << "Month: " << month << " Year: " << year
          << " | Avg Speed: " << avg << " | SD: " << sd << endl;
@@ -345,50 +594,29 @@ void WeatherLog::DisplayAvgSpeed(int month, int year)
 // Display average temperature and SD for each month of a year
 void WeatherLog::DisplayAvgTempSD(int year)
 {
-    if(!m_data.Contains(year))
+    if(!HasYear(year))
     {
         cout << "No data for year " << year << endl;
         return;
     }
 
-    Map<int, Bst<RecNode>>& months = m_data[year];
     Vector<int> monthKeys;
-    months.GetKeys(monthKeys);
+    GetMonthKeys(year, monthKeys);
 
     for(int m = 0; m < monthKeys.GetSize(); m++)
     {
         int month = monthKeys[m];
+        RecSummary summary;
+        SummarizeMonth(year, month, summary);
 
-        Vector<RecNode> nodes;
-        g_traverseBuffer = &nodes;
-        months[month].InOrder(CollectRecNode);
-        g_traverseBuffer = nullptr;
-
-        Vector<float> temps;
-        for(int i = 0; i < nodes.GetSize(); i++)
-        {
-            temps.Insert(temps.GetSize(), nodes[i].rec.GetAmbAirTemp());
-        }
-
-        if(temps.GetSize() == 0)
+        if(summary.GetCount() == 0)
         {
             continue;
         }
 
-        // Compute mean and standard deviation
-        float sum = 0.0f;
-        for(int i = 0; i < temps.GetSize(); i++)
-        {
-            sum += temps[i];
-        }
-        float avg = sum / temps.GetSize();
-
-        float sumSq = 0.0f;
-        for(int i = 0; i < temps.GetSize(); i++)
-        {
-            sumSq += (temps[i] - avg) * (temps[i] - avg);
-        }
-        float sd = (temps.GetSize() > 1) ? sqrt(sumSq / (temps.GetSize() - 1)) : 0.0f;
+        // Mean and standard deviation from the month's aggregates
+        float avg = static_cast<float>(summary.GetMean(FIELD_TEMP));
+        float sd = static_cast<float>(summary.GetSd(FIELD_TEMP));
 
         cout << "Month: " << month
              << " | Avg Temp: " << avg << " C"
@@ -405,11 +633,15 @@ float sPCC(const Vector<float>& X, const Vector<float>& Y)
         return 0.0f;
     }
 
+    // Sizes were checked above, so the loops index the raw arrays
+    const float* x = X.Data();
+    const float* y = Y.Data();
+
     float sumX = 0.0f, sumY = 0.0f;
     for(int i = 0; i < n; i++)
     {
-        sumX += X[i];
-        sumY += Y[i];
+        sumX += x[i];
+        sumY += y[i];
     }
 
     float meanX = sumX / n;
@@ -418,8 +650,8 @@ float sPCC(const Vector<float>& X, const Vector<float>& Y)
     float numerator = 0.0f, denomX = 0.0f, denomY = 0.0f;
     for(int i = 0; i < n; i++)
     {
-        float dx = X[i] - meanX;
-        float dy = Y[i] - meanY;
+        float dx = x[i] - meanX;
+        float dy = y[i] - meanY;
         numerator += dx * dy;
         denomX += dx * dx;
         denomY += dy * dy;
@@ -440,28 +672,28 @@ void WeatherLog::DisplaySPCC(int month)
 
     // Collect data across all years
     Vector<int> yearKeys;
-    m_data.GetKeys(yearKeys);
+    GetYearKeys(yearKeys);
 
+    MonthColumns scratch;
     for(int y = 0; y < yearKeys.GetSize(); y++)
     {
-        int yearKey = yearKeys[y];
-        Map<int, Bst<RecNode>>& months = m_data[yearKey];
-        if(!months.Contains(month))
+        const MonthColumns* columns = GetMonth(yearKeys[y], month, scratch);
+        if(columns == nullptr)
         {
             continue;
         }
 
-        Vector<RecNode> nodes;
-        g_traverseBuffer = &nodes;
-        months[month].InOrder(CollectRecNode);
-        g_traverseBuffer = nullptr;
-
-        for(int i = 0; i < nodes.GetSize(); i++)
+        for(float speed : columns->speed)
+        {
+            S.PushBack(speed);
+        }
+        for(float temp : columns->temp)
+        {
+            T.PushBack(temp);
+        }
+        for(float solar : columns->solar)
         {
-            WeatherRec& rec = nodes[i].rec;
-            S.Insert(S.GetSize(), rec.GetSpeed());
-            T.Insert(T.GetSize(), rec.GetAmbAirTemp());
-            R.Insert(R.GetSize(), rec.GetSolarRad());
+            R.PushBack(solar);
         }
     }
 
@@ -475,14 +707,441 @@ void WeatherLog::DisplaySPCC(int month)
     cout << "T_R: " << TR << endl;
 }
 
+// The sensor readings of one timestamp, from the batch that stored its record
+struct SensorGroup
+{
+    int batch;               // batch the readings came from
+    DuplicatePolicy policy;  // policy that batch was merged under
+    int count;               // rows read
+    int valid;               // rows with a reading
+    float first;             // reading of the first row, maybe NaN
+    float last;              // reading of the last row, maybe NaN
+    double sum;              // sum of the valid readings
+
+    SensorGroup() : batch(-1), policy(DUPLICATE_FIRST_WINS), count(0), valid(0), first(NAN), last(NAN), sum(0.0) {}
+};
+
+// Add one reading to its timestamp's group. A timestamp stored by an
+// earlier batch keeps that batch's readings, just as the record does.
+static void AddSensorSample(Map<unsigned long long, SensorGroup>& readings, const SensorSample& sample,
+                            int batch, DuplicatePolicy policy)
+{
+    SensorGroup& group = readings[sample.key];
+    if(group.batch != batch)
+    {
+        bool stored = group.count > 0 && !(group.policy == DUPLICATE_REJECT && group.count > 1);
+        if(stored)
+        {
+            return;
+        }
+        group = SensorGroup();
+        group.batch = batch;
+        group.policy = policy;
+    }
+
+    if(group.count == 0)
+    {
+        group.first = sample.value;
+    }
+    group.last = sample.value;
+    group.count++;
+    if(!std::isnan(sample.value))
+    {
+        group.sum += sample.value;
+        group.valid++;
+    }
+}
+
+// The reading the group's policy keeps; the average skips missing readings
+static float SensorReading(const SensorGroup& group)
+{
+    switch(group.policy)
+    {
+    case DUPLICATE_LAST_WINS:
+        return group.last;
+    case DUPLICATE_AVERAGE:
+        return (group.valid > 0) ? static_cast<float>(group.sum / group.valid) : NAN;
+    default:
+        return group.first;
+    }
+}
+
+// Read one sensor column for a month and store it beside the month's BST
+bool WeatherLog::LoadSensor(const string& code, int month, int year)
+{
+    if(!HasMonth(year, month))
+    {
+        return false;
+    }
+    if(m_sensors.Contains(code) && m_sensors[code].Contains(year) && m_sensors[code][year].Contains(month))
+    {
+        return true;
+    }
+
+    // Read the month batch by batch, files in manifest order within a
+    // batch, so the rows of a timestamp are seen in the order they were merged
+    Map<unsigned long long, SensorGroup> readings;
+    for(int b = 0; b < m_batchPolicies.GetSize(); b++)
+    {
+        for(int i = 0; i < m_sources.GetSize(); i++)
+        {
+            const SourceFile& source = m_sources[i];
+            for(int j = 0; j < source.batches.GetSize(); j++)
+            {
+                if(source.batches[j] != b)
+                {
+                    continue;
+                }
+
+                // A stream-loaded file has no spans and is read whole
+                int spanEnd = (j + 1 < source.batchStarts.GetSize()) ? source.batchStarts[j + 1] : source.spans.GetSize();
+                Vector<CsvSpan> spans;
+                for(int s = source.batchStarts[j]; s < spanEnd; s++)
+                {
+                    spans.PushBack(source.spans[s]);
+                }
+                if(spans.IsEmpty() && !source.spans.IsEmpty())
+                {
+                    continue;
+                }
+
+                Vector<SensorSample> samples;
+                if(ReadSensorMapped(source.path, code, spans, year, month, samples) != CSV_OK)
+                {
+                    cout << "Failed to open CSV File" << source.path << endl;
+                    continue;
+                }
+                for(int s = 0; s < samples.GetSize(); s++)
+                {
+                    AddSensorSample(readings, samples[s], b, m_batchPolicies[b]);
+                }
+            }
+        }
+    }
+
+    // Line the readings up with the month's records
+    MonthColumns scratch;
+    const MonthColumns* columns = GetMonth(year, month, scratch);
+
+    Vector<float>& column = m_sensors[code][year][month];
+    column.Clear();
+    const unsigned long long* keys = columns->keys.Data();
+    for(int i = 0; i < columns->GetSize(); i++)
+    {
+        unsigned long long key = keys[i];
+        column.PushBack(readings.Contains(key) ? SensorReading(readings[key]) : NAN);
+    }
+    return true;
+}
+
+// Display average and standard deviation of an on-demand sensor for a month/year
+void WeatherLog::DisplaySensorAvg(const string& code, int month, int year)
+{
+    if(code == "WAST")
+    {
+        cout << "WAST is the timestamp, not a sensor." << endl;
+        return;
+    }
+    if(!LoadSensor(code, month, year))
+    {
+        cout << "No data for " << month << "/" << year << endl;
+        return;
+    }
+
+    // Skip records without a reading
+    Vector<float> values;
+    for(float reading : m_sensors[code][year][month])
+    {
+        if(!std::isnan(reading))
+        {
+            values.PushBack(reading);
+        }
+    }
+
+    if(values.GetSize() == 0)
+    {
+        cout << "No " << code << " readings for " << month << "/" << year << endl;
+        return;
+    }
+
+    // Compute mean and standard deviation
+    float sum = 0.0f;
+    for(float value : values)
+    {
+        sum += value;
+    }
+    float avg = sum / values.GetSize();
+
+    float sumSq = 0.0f;
+    for(float value : values)
+    {
+        sumSq += (value - avg) * (value - avg);
+    }
+    float sd = (values.GetSize() > 1) ? sqrt(sumSq / (values.GetSize() - 1)) : 0.0f;
+
+    cout << "Month: " << month << " Year: " << year
+         << " | Avg " << code << ": " << avg << " | SD: " << sd
+         << " | Readings: " << values.GetSize() << endl;
+}
+
+// Collect the records between two timestamps from the overlapping months
+int WeatherLog::GetRange(const DateTimeKey& from, const DateTimeKey& to, MonthColumns& out)
+{
+    out.Clear();
+    Vector<int> years, months;
+    GetOverlappingMonths(from, to, years, months);
+    for(int i = 0; i < years.GetSize(); i++)
+    {
+        AppendRange(years[i], months[i], from, to, out);
+    }
+    return out.GetSize();
+}
+
+// Aggregates of the readings between two timestamps, from the overlapping months only
+int WeatherLog::SummarizeRange(const DateTimeKey& from, const DateTimeKey& to, RecSummary& out)
+{
+    out = RecSummary();
+    Vector<int> years, months;
+    GetOverlappingMonths(from, to, years, months);
+    for(int i = 0; i < years.GetSize(); i++)
+    {
+        SummarizeMonth(years[i], months[i], from, to, out);
+    }
+    return out.GetCount();
+}
+
+// List the stored months that overlap [from, to], in order
+void WeatherLog::GetOverlappingMonths(const DateTimeKey& from, const DateTimeKey& to,
+                                      Vector<int>& years, Vector<int>& months) const
+{
+    years.Clear();
+    months.Clear();
+    if(to < from)
+    {
+        return;
+    }
+
+    Vector<int> yearKeys;
+    GetYearKeys(yearKeys);
+    for(int y = 0; y < yearKeys.GetSize(); y++)
+    {
+        int year = yearKeys[y];
+        if(year < from.GetYear() || year > to.GetYear())
+        {
+            continue;
+        }
+
+        Vector<int> monthKeys;
+        GetMonthKeys(year, monthKeys);
+        for(int m = 0; m < monthKeys.GetSize(); m++)
+        {
+            int month = monthKeys[m];
+            if((year == from.GetYear() && month < from.GetMonth()) ||
+               (year == to.GetYear() && month > to.GetMonth()))
+            {
+                continue;
+            }
+            years.PushBack(year);
+            months.PushBack(month);
+        }
+    }
+}
+
+// Append the records of one month that fall inside [from, to]
+void WeatherLog::AppendRange(int year, int month, const DateTimeKey& from, const DateTimeKey& to, MonthColumns& out)
+{
+    if(m_storage == STORAGE_TREE)
+    {
+        // Only the nodes between the bounds are visited
+        m_data[year][month].VisitRange(RecNode(from), RecNode(to), [&out](const RecNode& node)
+        {
+            out.PushBack(node);
+        });
+        return;
+    }
+
+    // Columns are sorted by timestamp: binary search the first row
+    const MonthColumns& columns = m_columns[year][month];
+    int size = columns.GetSize();
+    if(size == 0)
+    {
+        return;
+    }
+    const unsigned long long* keys = columns.keys.Data();
+    const float* speeds = columns.speed.Data();
+    const float* temps = columns.temp.Data();
+    const float* solar = columns.solar.Data();
+    int first = static_cast<int>(std::lower_bound(keys, keys + size, from.GetPacked()) - keys);
+    for(int i = first; i < size && keys[i] <= to.GetPacked(); i++)
+    {
+        out.keys.PushBack(keys[i]);
+        out.speed.PushBack(speeds[i]);
+        out.temp.PushBack(temps[i]);
+        out.solar.PushBack(solar[i]);
+    }
+}
+
+// Add the aggregates of one month's records in [from, to]
+void WeatherLog::SummarizeMonth(int year, int month, const DateTimeKey& from, const DateTimeKey& to, RecSummary& out)
+{
+    if(m_storage == STORAGE_TREE)
+    {
+        // Whole subtrees come from their cached aggregates
+        out.Add(m_data[year][month].Summarize(RecNode(from), RecNode(to)));
+        return;
+    }
+
+    const MonthColumns& columns = m_columns[year][month];
+    int size = columns.GetSize();
+    if(size == 0)
+    {
+        return;
+    }
+    const unsigned long long* keys = columns.keys.Data();
+    const float* speeds = columns.speed.Data();
+    const float* temps = columns.temp.Data();
+    const float* solar = columns.solar.Data();
+    int first = static_cast<int>(std::lower_bound(keys, keys + size, from.GetPacked()) - keys);
+    for(int i = first; i < size && keys[i] <= to.GetPacked(); i++)
+    {
+        out.AddValue(RecNode(keys[i], speeds[i], solar[i], temps[i]));
+    }
+}
+
+// Aggregates of a whole month; O(1) in tree mode
+bool WeatherLog::SummarizeMonth(int year, int month, RecSummary& out)
+{
+    out = RecSummary();
+    if(!HasMonth(year, month))
+    {
+        return false;
+    }
+    if(m_storage == STORAGE_TREE)
+    {
+        out = m_data[year][month].Summarize();
+        return true;
+    }
+
+    const MonthColumns& columns = m_columns[year][month];
+    const unsigned long long* keys = columns.keys.Data();
+    const float* speeds = columns.speed.Data();
+    const float* temps = columns.temp.Data();
+    const float* solar = columns.solar.Data();
+    for(int i = 0; i < columns.GetSize(); i++)
+    {
+        out.AddValue(RecNode(keys[i], speeds[i], solar[i], temps[i]));
+    }
+    return true;
+}
+
+// Display speed, temperature and solar radiation for a time window
+void WeatherLog::DisplayRange(const DateTimeKey& from, const DateTimeKey& to)
+{
+    RecSummary summary;
+    int n = SummarizeRange(from, to, summary);
+
+    cout << "From " << from.GetDate() << " " << from.GetTime()
+         << " to " << to.GetDate() << " " << to.GetTime() << endl;
+    if(n == 0)
+    {
+        cout << "No data in this period" << endl;
+        return;
+    }
+
+    // Averages, SDs and total solar radiation straight from the aggregates
+    float avgSpeed = static_cast<float>(summary.GetMean(FIELD_SPEED));
+    float sdSpeed = static_cast<float>(summary.GetSd(FIELD_SPEED));
+    float avgTemp = static_cast<float>(summary.GetMean(FIELD_TEMP));
+    float sdTemp = static_cast<float>(summary.GetSd(FIELD_TEMP));
+    float totalSolar = static_cast<float>(summary.GetSum(FIELD_SOLAR));
+
+    cout << "Records: " << n
+         << " | Avg Speed: " << avgSpeed << " km/h (SD: " << sdSpeed << ")"
+         << " | Avg Temp: " << avgTemp << " C (SD: " << sdTemp << ")"
+         << " | Total Solar: " << totalSolar << " kWh/m2" << endl;
+}
+
+// Build (once) the value-ordered trees of a month
+const MonthValues* WeatherLog::GetValues(int year, int month)
+{
+    if(!HasMonth(year, month))
+    {
+        return nullptr;
+    }
+    if(m_values.Contains(year) && m_values[year].Contains(month))
+    {
+        return &m_values[year][month];
+    }
+
+    // Built by insertion, the same way later records are added (see AddPartitions())
+    MonthColumns scratch;
+    const MonthColumns* columns = GetMonth(year, month, scratch);
+    MonthValues& values = m_values[year][month];
+    const unsigned long long* keys = columns->keys.Data();
+    const float* speeds = columns->speed.Data();
+    const float* temps = columns->temp.Data();
+    const float* solar = columns->solar.Data();
+    for(int i = 0; i < columns->GetSize(); i++)
+    {
+        AddReadings(values, keys[i], speeds[i], temps[i], solar[i]);
+    }
+    return &values;
+}
+
+// Percentile of one field for a month, interpolating between ranks
+bool WeatherLog::GetPercentile(int year, int month, RecField field, float percent, float& out)
+{
+    const MonthValues* values = GetValues(year, month);
+    if(values == nullptr || percent < 0.0f || percent > 100.0f)
+    {
+        return false;
+    }
+
+    const ValueTree& tree = values->fields[field];
+    int count = tree.GetSize();
+    if(count == 0)
+    {
+        return false;
+    }
+
+    float position = percent / 100.0f * (count - 1);
+    int below = static_cast<int>(position);
+    int above = (below + 1 < count) ? below + 1 : below;
+    float low = tree.Select(below)->value;
+    float high = tree.Select(above)->value;
+    out = low + (high - low) * (position - below);
+    return true;
+}
+
+// Display median and 95th percentile of speed, temperature and solar radiation
+void WeatherLog::DisplayPercentiles(int month, int year)
+{
+    float speed50, speed95, temp50, temp95, solar50, solar95;
+    if(!GetPercentile(year, month, FIELD_SPEED, 50.0f, speed50) ||
+       !GetPercentile(year, month, FIELD_SPEED, 95.0f, speed95) ||
+       !GetPercentile(year, month, FIELD_TEMP, 50.0f, temp50) ||
+       !GetPercentile(year, month, FIELD_TEMP, 95.0f, temp95) ||
+       !GetPercentile(year, month, FIELD_SOLAR, 50.0f, solar50) ||
+       !GetPercentile(year, month, FIELD_SOLAR, 95.0f, solar95))
+    {
+        cout << "No data for " << month << "/" << year << endl;
+        return;
+    }
+
+    cout << "Month: " << month << " Year: " << year
+         << " | Speed median: " << speed50 << " km/h, 95th: " << speed95
+         << " | Temp median: " << temp50 << " C, 95th: " << temp95
+         << " | Solar median: " << solar50 << " kWh/m2, 95th: " << solar95 << endl;
+}
+
 // Compute Mean Absolute Deviation
 float MeanAbsoluteDeviation(const Vector<float>& data, float mean)
 {
     float mad = 0.0f;
     int n = data.GetSize();
-    for(int i = 0; i < n; i++)
+    for(float value : data)
     {
-        mad += fabs(data[i] - mean);
+        mad += fabs(value - mean);
     }
     return (n > 0) ? (mad / n) : 0.0f;
 }
@@ -500,30 +1159,21 @@ void WeatherLog::DisplaySpeedTempSolarRadWithMAD(int year)
     file << year << "\n";
     file << "Month,Average Wind Speed(stdev,mad),Average Ambient Temperature(stdev,mad),Total Solar Radiation\n";
 
-    Map<int, Bst<RecNode>>& months = m_data[year];
-
+    MonthColumns scratch;
     for(int month = 1; month <= 12; month++)
     {
-        if(!months.Contains(month))
+        const MonthColumns* columns = GetMonth(year, month, scratch);
+        if(columns == nullptr)
         {
             continue;
         }
 
-        Vector<RecNode> nodes;
-        g_traverseBuffer = &nodes;
-        months[month].InOrder(CollectRecNode);
-        g_traverseBuffer = nullptr;
-
-        Vector<float> speeds, temps, solar;
-        for(int i = 0; i < nodes.GetSize(); i++)
-        {
-            WeatherRec& rec = nodes[i].rec;
-            speeds.Insert(speeds.GetSize(), rec.GetSpeed());
-            temps.Insert(temps.GetSize(), rec.GetAmbAirTemp());
-            solar.Insert(solar.GetSize(), rec.GetSolarRad() * 0.0001667f); // kWh/m2
-        }
+        // Every column has one entry per record, so the loops index the raw arrays
+        const float* speeds = columns->speed.Data();
+        const float* temps = columns->temp.Data();
+        const float* solar = columns->solar.Data();
 
-        int n = speeds.GetSize();
+        int n = columns->GetSize();
         if(n == 0)
         {
             continue;
@@ -535,7 +1185,7 @@ void WeatherLog::DisplaySpeedTempSolarRadWithMAD(int year)
         {
             avgSpeed += speeds[i];
             avgTemp += temps[i];
-            totalSolar += solar[i];
+            totalSolar += solar[i] * 0.0001667f; // kWh/m2
         }
         avgSpeed /= n;
         avgTemp /= n;
@@ -551,8 +1201,8 @@ void WeatherLog::DisplaySpeedTempSolarRadWithMAD(int year)
         sdTemp = (n > 1) ? sqrt(sdTemp / (n - 1)) : 0.0f;
 
         // Compute MAD
-        float madSpeed = MeanAbsoluteDeviation(speeds, avgSpeed);
-        float madTemp = MeanAbsoluteDeviation(temps, avgTemp);
+        float madSpeed = MeanAbsoluteDeviation(columns->speed, avgSpeed);
+        float madTemp = MeanAbsoluteDeviation(columns->temp, avgTemp);
 
         // Write row to CSV
         file << month << ","
@@ -2,17 +2,177 @@
 #define WEATHERLOG_H_INCLUDED
 
 #include <string>
+#include <type_traits>
 #include "Map.h"
-#include "BST.h"
+#include "Bst.h"
 #include "Date.h"
 #include "Time.h"
 #include "EncapVect.h"
 #include "DateTimeKey.h"
 #include "WeatherRec.h"
 #include "RecNode.h"
+#include "CsvParser.h"
+#include "MonthColumns.h"
+#include "RecSort.h"
 
 using std::string;
 
+/**
+ * @brief Selects how LoadData reads each CSV file.
+ */
+enum LoadMode
+{
+    LOAD_STREAM,  ///< getline + stringstream, one string per field (original loader).
+    LOAD_MAPPED   ///< Memory-mapped file, fields tokenized in place without allocation.
+};
+
+/**
+ * @brief The readings WeatherLog computes statistics on.
+ */
+enum RecField
+{
+    FIELD_SPEED, ///< Wind speed (km/h).
+    FIELD_TEMP,  ///< Ambient air temperature.
+    FIELD_SOLAR, ///< Solar radiation.
+    FIELD_COUNT  ///< Number of fields.
+};
+
+/**
+ * @struct RecFields
+ * @brief The RecField readings of a RecNode, for BstAggregate.
+ */
+struct RecFields
+{
+    static const int count = FIELD_COUNT; ///< Number of fields.
+
+    /** @brief Reading @p field of @p node. */
+    static double Get(const RecNode& node, int field)
+    {
+        switch(field)
+        {
+        case FIELD_SPEED:
+            return node.rec.GetSpeed();
+        case FIELD_TEMP:
+            return node.rec.GetAmbAirTemp();
+        default:
+            return node.rec.GetSolarRad();
+        }
+    }
+};
+
+/**
+ * @brief Count, sums and sums of squares of the RecField readings of some records.
+ */
+typedef BstAggregate<RecFields>::Summary RecSummary;
+
+/**
+ * @brief BST holding one month of records in tree mode.
+ *
+ * AVL-balanced, so a month that several files (or appended rows)
+ * contribute to stays O(log n) deep whatever order the rows arrive in.
+ * Nodes come from a per-month arena, so a month is freed in one go.
+ * Every node caches the count, sum and sum of squares of each reading
+ * over its subtree, so the mean and SD of any time window of the month
+ * take O(log n) (see WeatherLog::SummarizeRange()).
+ */
+typedef Bst<RecNode, BstAvl, BstArena, BstAggregate<RecFields> > MonthTree;
+
+/**
+ * @struct SensorValue
+ * @brief One reading, ordered by value and then by timestamp.
+ *
+ * The timestamp keeps equal readings apart, so a ValueTree holds every
+ * reading of a month even though Bst ignores duplicates.
+ */
+struct SensorValue
+{
+    float value;            ///< The reading.
+    unsigned long long key; ///< Timestamp packed by PackDateTime().
+
+    bool operator<(const SensorValue& other) const
+    {
+        return value < other.value || (value == other.value && key < other.key);
+    }
+
+    bool operator>(const SensorValue& other) const
+    {
+        return other < *this;
+    }
+
+    bool operator==(const SensorValue& other) const
+    {
+        return value == other.value && key == other.key;
+    }
+};
+
+/**
+ * @brief One month of one field's readings, sorted by value.
+ *
+ * Nodes know their subtree sizes, so the k-th smallest reading (and so
+ * any percentile) is found in O(log n).
+ */
+typedef Bst<SensorValue, BstAvl, BstArena, BstSize> ValueTree;
+
+/**
+ * @struct MonthValues
+ * @brief Value-ordered trees of one month, one per RecField.
+ */
+struct MonthValues
+{
+    ValueTree fields[FIELD_COUNT]; ///< Indexed by RecField.
+};
+
+/**
+ * @brief Selects how WeatherLog keeps the records of each month.
+ */
+enum StorageMode
+{
+    STORAGE_TREE,     ///< One MonthTree per month (original layout).
+    STORAGE_COLUMNAR  ///< One MonthColumns per month: sorted timestamp and float columns.
+};
+
+/**
+ * @struct SourceFile
+ * @brief A CSV file that was loaded, with the month ranges of its rows.
+ *
+ * Kept so that sensor columns which are not loaded up front can be read
+ * from the file later, one month at a time, and so that rows appended to
+ * the file can be picked up without reading it again.
+ */
+struct SourceFile
+{
+    string path;             ///< data/<file name>
+    Vector<CsvSpan> spans;   ///< Month ranges recorded by the mapped loader; empty after a stream load.
+    LoadStats stats;         ///< Rows of this file that were not loaded, by reason.
+    long long offset;        ///< Bytes read so far, or -1 if the file is not followed.
+    long long lines;         ///< Lines read so far, including the header.
+    bool heldBack;           ///< The last read left an unfinished final row at @p offset.
+    Vector<int> batchStarts; ///< Index in @p spans where each batch of this file's records starts.
+    Vector<int> batches;     ///< Batch number of each entry of @p batchStarts (see WeatherLog::m_batchPolicies).
+
+    /**
+     * @brief Constructs an entry for a file that is not followed.
+     */
+    SourceFile()
+        : offset(-1), lines(0), heldBack(false)
+    {
+    }
+};
+
+// Vector grows by moving its elements only when the move cannot throw;
+// otherwise every month, partition and source would be copied on growth
+static_assert(std::is_nothrow_move_constructible<SourceFile>::value &&
+              std::is_nothrow_move_constructible<MonthColumns>::value &&
+              std::is_nothrow_move_constructible<MonthTree>::value &&
+              std::is_nothrow_move_constructible<MonthValues>::value &&
+              std::is_nothrow_move_constructible<RecPartitions>::value &&
+              std::is_nothrow_move_constructible<Vector<CsvSpan> >::value,
+              "Stored containers must have noexcept moves");
+static_assert(std::is_nothrow_move_assignable<MonthTree>::value &&
+              std::is_nothrow_move_assignable<RecPartitions>::value &&
+              std::is_nothrow_move_assignable<Vector<RecNode> >::value,
+              "Stored containers must have noexcept move assignment");
+
 /**
  * @class WeatherLog
  * @brief Loads, stores, and performs statistical analysis on weather records.
@@ -23,11 +183,19 @@ using std::string;
  *
  * Internally, data is stored in a three-level structure:
  *
- *     Map<year, Map<month, Bst<RecNode>>>
+ *     Map<year, Map<month, MonthTree>>
  *
  * Each RecNode contains a WeatherRec and is inserted into the BST using
  * a DateTimeKey, ensuring chronological ordering and fast searching.
  *
+ * With STORAGE_COLUMNAR each month is instead a MonthColumns: a sorted
+ * packed-timestamp column and contiguous speed, temperature and solar
+ * columns. Means and SDs come from count, sum and sum-of-squares
+ * aggregates (RecSummary): cached in every node in tree mode, so they
+ * cost O(log n) for any window; scanned from the columns in columnar
+ * mode. Other statistics scan a month's columns; in tree mode the
+ * month's BST is first copied into temporary columns in order.
+ *
  * The class provides methods for computing:
  *   - Average wind speed (with standard deviation)
  *   - Average ambient air temperature (with standard deviation)
@@ -43,8 +211,9 @@ public:
 
     /**
      * @brief Constructs an empty WeatherLog container.
+     * @param storage How the records of each month are kept (default: STORAGE_TREE).
      */
-    WeatherLog();
+    explicit WeatherLog(StorageMode storage = STORAGE_TREE);
 
     /**
      * @brief Loads and parses all weather data from CSV files.
@@ -60,9 +229,83 @@ public:
      *   - WAST timestamp cannot be parsed
      *   - The required numeric values (S, T, SR) are not valid numbers
      *
+     * Skipped rows are counted by reason while parsing, without any console
+     * output per row. One summary, with a few sample line numbers per file,
+     * is printed after all files are loaded (see GetLoadStats()).
+     *
+     * In LOAD_MAPPED mode every file is memory-mapped and rows are split into
+     * slices of the mapped buffer, so no per-field strings are allocated.
+     * The modes differ only in rows whose field count differs from the
+     * header: LOAD_STREAM rejects them as short rows, while LOAD_MAPPED
+     * accepts any row that reaches the WAST, S, T and SR columns.
+     *
+     * Files are parsed concurrently, each on its own worker thread and into
+     * its own year/month partitions, and each month is sorted by time. The
+     * files' runs for a month are then merged in one pass, in manifest
+     * order, so the result is the same as a serial load. Records sharing a
+     * timestamp, in one file or across files, are resolved by the
+     * duplicate policy (see SetDuplicatePolicy()) and counted as skipped
+     * duplicate rows; the total printed counts only the records kept.
+     *
+     * When the manifest lists fewer files than there are threads, the
+     * spare threads parse newline-aligned chunks of each mapped file
+     * concurrently, so a single very large CSV also loads in parallel.
+     *
+     * With @p follow set, LOAD_MAPPED files are followed by
+     * PollAppendedData(). A final row without a newline may still be
+     * being written, so it is held back until a later poll finds it
+     * finished, and counted as an unfinished last row meanwhile.
+     * Without @p follow every file is read to its end.
+     *
+     * @param mode    How the CSV files are read (default: LOAD_MAPPED).
+     * @param threads Maximum worker threads; 0 = one per hardware thread, 1 = serial.
+     * @param follow  Follow the files for appended rows (LOAD_MAPPED only; default: false).
      * @return True if all accessible files were processed, false if none succeeded.
      */
-    bool LoadData();
+    bool LoadData(LoadMode mode = LOAD_MAPPED, int threads = 0, bool follow = false);
+
+    /**
+     * @brief Returns the counts of rows skipped by LoadData, by reason.
+     *
+     * Counts cover every file loaded so far. Per-file counts and sample
+     * line numbers are included in the summary LoadData prints. Duplicate
+     * timestamps are found when the files' runs are merged, after parsing,
+     * so they are counted per file without line numbers.
+     */
+    const LoadStats& GetLoadStats() const;
+
+    /**
+     * @brief Chooses which record is kept when several share a timestamp.
+     *
+     * Applies to records loaded from now on that share a timestamp with
+     * each other. Records already stored are never replaced: a new row
+     * repeating a stored timestamp is dropped as a duplicate, whatever the
+     * policy. Sensor columns read on demand (LoadSensor()) resolve repeated
+     * timestamps by the policy their records were merged under.
+     *
+     * @param policy Duplicate policy (default: DUPLICATE_FIRST_WINS).
+     */
+    void SetDuplicatePolicy(DuplicatePolicy policy);
+
+    /**
+     * @brief Returns the current duplicate policy.
+     */
+    DuplicatePolicy GetDuplicatePolicy() const;
+
+    /**
+     * @brief Loads rows appended to the data files since they were last read.
+     *
+     * Every file loaded with follow set is read again from the byte
+     * offset its last read stopped at; only complete rows after that offset
+     * are parsed. A row held back as unfinished is uncounted first, and is
+     * either loaded now or counted again. The new records are inserted into
+     * the BSTs of their own month, so other months are not touched. Sensor
+     * columns already read for an updated month are dropped and read again
+     * on the next request. Other files are not followed.
+     *
+     * @return Number of new records parsed.
+     */
+    int PollAppendedData();
 
     /**
      * @brief Displays the average wind speed and standard deviation for a given month/year.
@@ -100,6 +343,87 @@ public:
      */
     void DisplaySPCC(int month);
 
+    /**
+     * @brief Displays the average and standard deviation of any other sensor for a month/year.
+     *
+     * Only WAST, S, T and SR are loaded by LoadData(). The first time a
+     * sensor such as DP, RH, QFE, Sx or ST1-ST4 is requested for a month,
+     * that one column is read from the byte ranges of the month recorded
+     * at load time and stored alongside the month's BST; later requests
+     * reuse it. Readings are shown as stored in the files, without unit
+     * conversion. Missing or invalid readings are left out.
+     *
+     * @param code  Sensor code as it appears in the CSV header (see data/SensorCodes.rtf).
+     * @param month Month number (1-12).
+     * @param year  Full year (e.g., 2024).
+     */
+    void DisplaySensorAvg(const string& code, int month, int year);
+
+    /**
+     * @brief Copies the records between two timestamps into columns.
+     *
+     * Only the months that overlap the window are looked at. Within a
+     * month, tree mode walks just the nodes in range (Bst::VisitRange)
+     * and columnar mode binary-searches the timestamp column.
+     *
+     * @param from First timestamp, inclusive.
+     * @param to   Last timestamp, inclusive.
+     * @param out  Cleared, then filled with the records in time order.
+     * @return Number of records found.
+     */
+    int GetRange(const DateTimeKey& from, const DateTimeKey& to, MonthColumns& out);
+
+    /**
+     * @brief Count, sums and sums of squares of the readings between two timestamps.
+     *
+     * In tree mode each overlapping month answers from its nodes' cached
+     * aggregates in O(log n), without visiting the records in between.
+     * In columnar mode the window's rows are found by binary search and
+     * scanned.
+     *
+     * @param from First timestamp, inclusive.
+     * @param to   Last timestamp, inclusive.
+     * @param out  Receives the aggregates.
+     * @return Number of records in the window.
+     */
+    int SummarizeRange(const DateTimeKey& from, const DateTimeKey& to, RecSummary& out);
+
+    /**
+     * @brief Displays wind speed, temperature and solar radiation between two timestamps.
+     *
+     * Shows the number of records, average wind speed and ambient
+     * temperature with their SDs, and total solar radiation, for the
+     * window [from, to], which may span several months or years.
+     *
+     * @param from First timestamp, inclusive.
+     * @param to   Last timestamp, inclusive.
+     */
+    void DisplayRange(const DateTimeKey& from, const DateTimeKey& to);
+
+    /**
+     * @brief Returns a percentile of one field's readings for a month.
+     *
+     * Interpolates linearly between the two closest ranks, so 50 gives
+     * the median. The month's value-ordered trees are built on first use
+     * (O(n log n)) and kept until the month changes; after that each
+     * query is O(log n).
+     *
+     * @param year    Full year.
+     * @param month   Month number (1-12).
+     * @param field   Which reading.
+     * @param percent Percentile, 0 to 100.
+     * @param out     Receives the percentile.
+     * @return False if there are no readings for the month or @p percent is out of range.
+     */
+    bool GetPercentile(int year, int month, RecField field, float percent, float& out);
+
+    /**
+     * @brief Displays the median and 95th percentile of each field for a month.
+     * @param month Month number (1-12).
+     * @param year  Full year.
+     */
+    void DisplayPercentiles(int month, int year);
+
     /**
      * @brief Displays combined monthly statistics for a given year.
      *
@@ -137,17 +461,223 @@ public:
     void PrintToCsv(int year);
 
 private:
+    /**
+     * @brief Merges the records of a batch of files into the stored months.
+     *
+     * For each month, rows whose timestamp is already stored are dropped
+     * from each file's sorted run and counted against that file. The runs
+     * are then merged with MergeSortedRuns() under m_duplicates. A new
+     * month is built from the result in one pass; a stored month has the
+     * result inserted (see AddToMonth()).
+     *
+     * @param batch   Records of each file, grouped by year and month and sorted (see SortPartitions()).
+     * @param dropped Receives the duplicates counted against each file of @p batch.
+     * @return Total number of duplicates in the batch.
+     */
+    int AddPartitions(const Vector<RecPartitions*>& batch, Vector<int>& dropped);
+
+    /**
+     * @brief Builds a month that has no records yet from a sorted run of unique records.
+     *
+     * Nothing is stored if @p merged is empty.
+     *
+     * @param year   Full year.
+     * @param month  Month number (1-12).
+     * @param merged The month's records.
+     */
+    void StoreMonth(int year, int month, const Vector<RecNode>& merged);
+
+    /**
+     * @brief Adds records to a stored month.
+     *
+     * In STORAGE_TREE mode each record is inserted into the month's AVL
+     * tree, O(log n) per record. In STORAGE_COLUMNAR mode records that all
+     * follow the stored ones are appended; otherwise the columns are merged.
+     *
+     * @param year  Full year.
+     * @param month Month number (1-12); must have records.
+     * @param added Sorted records, none sharing a timestamp with each other or with the month.
+     */
+    void AddToMonth(int year, int month, const Vector<RecNode>& added);
+
+    /**
+     * @brief Checks whether a stored month has a record with a timestamp.
+     * @param year  Full year.
+     * @param month Month number (1-12); must have records.
+     * @param key   Timestamp to look for.
+     * @return True if the month has a record with @p key.
+     */
+    bool HasRecord(int year, int month, const DateTimeKey& key) const;
+
+    /**
+     * @brief Appends one month's records with from <= timestamp <= to.
+     * @param year  Full year.
+     * @param month Month number (1-12).
+     * @param from  First timestamp, inclusive.
+     * @param to    Last timestamp, inclusive.
+     * @param out   Columns to append to.
+     */
+    void AppendRange(int year, int month, const DateTimeKey& from, const DateTimeKey& to, MonthColumns& out);
+
+    /**
+     * @brief Adds the aggregates of one month's records with from <= timestamp <= to.
+     * @param year  Full year.
+     * @param month Month number (1-12).
+     * @param from  First timestamp, inclusive.
+     * @param to    Last timestamp, inclusive.
+     * @param out   Aggregates to add to.
+     */
+    void SummarizeMonth(int year, int month, const DateTimeKey& from, const DateTimeKey& to, RecSummary& out);
+
+    /**
+     * @brief Aggregates of every record of a month.
+     * @param year  Full year.
+     * @param month Month number (1-12).
+     * @param out   Receives the aggregates.
+     * @return False if there is no data for the month.
+     */
+    bool SummarizeMonth(int year, int month, RecSummary& out);
+
+    /**
+     * @brief Lists the stored months that overlap [from, to], in time order.
+     * @param from   First timestamp, inclusive.
+     * @param to     Last timestamp, inclusive.
+     * @param years  Receives the year of each month.
+     * @param months Receives the month numbers, parallel to @p years.
+     */
+    void GetOverlappingMonths(const DateTimeKey& from, const DateTimeKey& to,
+                              Vector<int>& years, Vector<int>& months) const;
+
+    /**
+     * @brief Checks whether any records are stored for a year.
+     */
+    bool HasYear(int year) const;
+
+    /**
+     * @brief Checks whether any records are stored for a month.
+     */
+    bool HasMonth(int year, int month) const;
+
+    /**
+     * @brief Lists the years with stored records, in ascending order.
+     */
+    void GetYearKeys(Vector<int>& out) const;
+
+    /**
+     * @brief Lists the months of a year with stored records, in ascending order.
+     */
+    void GetMonthKeys(int year, Vector<int>& out) const;
+
+    /**
+     * @brief Returns the records of one month as sorted columns.
+     *
+     * In columnar mode this is the stored MonthColumns itself. In tree
+     * mode the month's BST is traversed in order into @p scratch.
+     *
+     * @param year    Year of the month.
+     * @param month   Month number (1-12).
+     * @param scratch Storage for the columns in tree mode.
+     * @return The month's columns, or nullptr if there is no data for it.
+     */
+    const MonthColumns* GetMonth(int year, int month, MonthColumns& scratch);
+
+    /**
+     * @brief Returns a month's value-ordered trees, building them if needed.
+     *
+     * The trees are built on the first request for a month, O(n log n).
+     * Records added to the month afterwards are inserted into them,
+     * O(log n) each, so they are never rebuilt.
+     * @return The trees, or nullptr if there is no data for the month.
+     */
+    const MonthValues* GetValues(int year, int month);
+
+    /**
+     * @brief Prints the summary of skipped rows, if there were any.
+     */
+    void PrintLoadStats() const;
+
+    /**
+     * @brief Drops the stored sensor columns of every month in @p tempData.
+     * @param tempData Records just added, grouped by year and month.
+     */
+    void ForgetSensors(RecPartitions& tempData);
+
+    /**
+     * @brief Reads a sensor column for one month, unless it is already stored.
+     *
+     * The values are stored in m_sensors in the chronological position of
+     * their records within the month, with NaN for records without a reading.
+     * Rows sharing a timestamp are resolved batch by batch, by the policy
+     * each batch was merged under, so a record's reading comes from the
+     * same row (or rows, averaged) as its speed, temperature and solar.
+     *
+     * @param code  Sensor code from the CSV header.
+     * @param month Month number (1-12).
+     * @param year  Full year.
+     * @return False if there is no data for the month.
+     */
+    bool LoadSensor(const string& code, int month, int year);
+
     /**
      * @brief Hierarchical weather data storage.
      *
      * Structure:
-     *     m_data[year][month] → BST sorted by DateTimeKey
+     *     m_data[year][month] → AVL-balanced BST sorted by DateTimeKey
      *
      * Ensures:
      *   - Fast access by year/month
      *   - Chronological ordering within each month
      */
-    Map<int, Map<int, Bst<RecNode>>> m_data;
+    Map<int, Map<int, MonthTree>> m_data;
+
+    /**
+     * @brief Columnar storage: m_columns[year][month] (STORAGE_COLUMNAR only).
+     */
+    Map<int, Map<int, MonthColumns>> m_columns;
+
+    /**
+     * @brief Which of m_data and m_columns holds the records.
+     */
+    StorageMode m_storage;
+
+    /**
+     * @brief Which record is kept when several share a timestamp.
+     */
+    DuplicatePolicy m_duplicates;
+
+    /**
+     * @brief Files loaded into m_data, in manifest order.
+     */
+    Vector<SourceFile> m_sources;
+
+    /**
+     * @brief Duplicate policy each batch of records was merged under, by batch number.
+     *
+     * A batch is one LoadData() call, or the rows of one file added by
+     * PollAppendedData(). Timestamps are resolved within the first batch
+     * that stores them.
+     */
+    Vector<DuplicatePolicy> m_batchPolicies;
+
+    /**
+     * @brief Skipped-row counts summed over m_sources.
+     */
+    LoadStats m_loadStats;
+
+    /**
+     * @brief Sensor columns read on demand.
+     *
+     * m_sensors[code][year][month] holds one value per record of the
+     * month, in chronological order.
+     */
+    Map<string, Map<int, Map<int, Vector<float>>>> m_sensors;
+
+    /**
+     * @brief Value-ordered trees built by GetValues(), m_values[year][month].
+     *
+     * Records added to a month that has trees are inserted into them.
+     */
+    Map<int, Map<int, MonthValues>> m_values;
 };
 
 #endif // WEATHERLOG_H_INCLUDED
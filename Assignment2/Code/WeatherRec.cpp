@@ -7,6 +7,7 @@ using std::setfill;
 
 // Default constructor: initializes all numeric fields to 0 and date/time to default
 WeatherRec::WeatherRec()
+    : m_when(Date(), Time())
 {
     m_speed = 0.0f;
     m_solarRad = 0.0f;
@@ -15,36 +16,44 @@ WeatherRec::WeatherRec()
 
 // Constructor with specified values for date, time, wind speed, solar radiation, and air temperature
 WeatherRec::WeatherRec(const Date& d, const Time& t, float speed, float solarRad, float ambAirTemp)
+    : m_when(d, t)
 {
-    m_date = d;
-    m_time = t;
     m_speed = speed;
     m_solarRad = solarRad;
     m_airTemp = ambAirTemp;
 }
 
-// Returns the date of the weather record
-const Date& WeatherRec::GetDate() const
+// Constructor from a packed timestamp and the readings
+WeatherRec::WeatherRec(const DateTimeKey& when, float speed, float solarRad, float ambAirTemp)
+    : m_when(when)
 {
-    return m_date;
+    m_speed = speed;
+    m_solarRad = solarRad;
+    m_airTemp = ambAirTemp;
 }
 
-// Returns the time of the weather record
-const Time& WeatherRec::GetTime() const
+// Returns the date of the weather record, unpacked from its key
+Date WeatherRec::GetDate() const
 {
-    return m_time;
+    return m_when.GetDate();
+}
+
+// Returns the time of the weather record, unpacked from its key
+Time WeatherRec::GetTime() const
+{
+    return m_when.GetTime();
 }
 
 // Returns the month of the weather record
 int WeatherRec::GetMonth() const
 {
-    return m_date.GetMonth();
+    return m_when.GetMonth();
 }
 
 // Returns the year of the weather record
 int WeatherRec::GetYear() const
 {
-    return m_date.GetYear();
+    return m_when.GetYear();
 }
 
 // Returns the recorded wind speed
@@ -68,13 +77,13 @@ float WeatherRec::GetAmbAirTemp() const
 // Sets the date of the record
 void WeatherRec::SetDate(const Date& d)
 {
-    m_date = d;
+    m_when = DateTimeKey(d, m_when.GetTime());
 }
 
 // Sets the time of the record
 void WeatherRec::SetTime(const Time& t)
 {
-    m_time = t;
+    m_when = DateTimeKey(m_when.GetDate(), t);
 }
 
 // Sets the wind speed of the record
@@ -95,12 +104,6 @@ void WeatherRec::SetAmbAirTemp(float ambAirTemp)
     m_airTemp = ambAirTemp;
 }
 
-// Returns a DateTimeKey object for this record (useful for BST sorting)
-DateTimeKey WeatherRec::GetDateTimeKey() const
-{
-    return DateTimeKey(m_date, m_time);
-}
-
 // Output stream operator: prints the weather record in a readable format
 ostream& operator<<(ostream& os, const WeatherRec& wr)
 {
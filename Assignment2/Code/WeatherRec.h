@@ -21,6 +21,8 @@ using std::ostream;
  *
  * Each record can generate a DateTimeKey, which provides a unique
  * and fully sortable timestamp suitable for use as the key in a BST.
+ * The date and time are stored as that packed key and are only turned
+ * back into Date and Time objects when asked for.
  */
 class WeatherRec
 {
@@ -46,11 +48,21 @@ public:
      */
     WeatherRec(const Date& d, const Time& t, float speed, float solarRad, float ambAirTemp);
 
+    /**
+     * @brief Creates a weather record from an already packed timestamp.
+     *
+     * @param when Timestamp of the observation.
+     * @param speed Wind speed in m/s.
+     * @param solarRad Solar radiation in W/m.
+     * @param ambAirTemp Ambient air temperature in C.
+     */
+    WeatherRec(const DateTimeKey& when, float speed, float solarRad, float ambAirTemp);
+
     /** @brief Returns the observation date. */
-    const Date& GetDate() const;
+    Date GetDate() const;
 
     /** @brief Returns the observation time. */
-    const Time& GetTime() const;
+    Time GetTime() const;
 
     /**
      * @brief Returns the month of the observation.
@@ -102,13 +114,19 @@ public:
     DateTimeKey GetDateTimeKey() const;
 
 private:
-    Date m_date;       /**< Observation date. */
-    Time m_time;       /**< Observation time. */
+    DateTimeKey m_when; /**< Observation date and time, packed. */
     float m_speed;     /**< Wind speed (m/s). */
     float m_solarRad;  /**< Solar radiation (W/m). */
     float m_airTemp;   /**< Ambient air temperature (C). */
 };
 
+// Defined inline: RecNode orders records by this key, so every
+// comparison in the sorts, merges and BSTs goes through it
+inline DateTimeKey WeatherRec::GetDateTimeKey() const
+{
+    return m_when;
+}
+
 /**
  * @brief Stream insertion operator for WeatherRec.
  *